@@ -3,6 +3,7 @@
 #include <cassert>
 #include <iterator>
 #include <map>
+#include <tuple>
 
 namespace lab {
 
@@ -127,47 +128,42 @@ bool operator!=(const BigNum& left, const BigNum& right) noexcept {
 }
 
 BigNum operator+(const BigNum &left, const BigNum &right) {
-    if (right._digits.size() > left._digits.size()) {
-        auto result = right;
-        int addition = 0;
-        for (int curr_pos = 0; curr_pos < left._digits.size(); ++curr_pos) {
-            result._digits[curr_pos] += left._digits[curr_pos] + addition;
-            addition = result._digits[curr_pos] / NUM_BASE;
-            result._digits[curr_pos] = result._digits[curr_pos] % NUM_BASE;
-        }
+    const auto& longer = left._digits.size() >= right._digits.size() ? left : right;
+    const auto& shorter = left._digits.size() >= right._digits.size() ? right : left;
+    auto result = longer;
+    int64_t addition = 0;
 
-        return result;
-    } else {
-        auto result = left;
-        int addition = 0;
-
-        for (int curr_pos = 0; curr_pos < right._digits.size(); ++curr_pos) {
-            long long temp = static_cast<long long>(result._digits[curr_pos])
-                    + static_cast<long long>(right._digits[curr_pos]) + addition;
-            result._digits[curr_pos] = temp % NUM_BASE;
-            addition = temp / NUM_BASE;
-            result._digits[curr_pos] = result._digits[curr_pos] % NUM_BASE;
+    for (int curr_pos = 0; curr_pos < result._digits.size(); ++curr_pos) {
+        if (curr_pos >= shorter._digits.size() && addition == 0) {
+            break;
         }
-
-        return result;
+        result._digits[curr_pos] += addition;
+        if (curr_pos < shorter._digits.size()) {
+            result._digits[curr_pos] += shorter._digits[curr_pos];
+        }
+        addition = result._digits[curr_pos] / NUM_BASE;
+        result._digits[curr_pos] = result._digits[curr_pos] % NUM_BASE;
     }
+    if (addition != 0) {
+        result._digits.push_back(addition);
+    }
+
+    return result;
 }
 
 BigNum operator-(const BigNum &left, const BigNum &right) {
     BigNum result = left;
-    for (int curr_pos = 0; curr_pos < right._digits.size(); ++curr_pos) {
-        if (result._digits[curr_pos] < right._digits[curr_pos]) {
-            result._digits[curr_pos] = result._digits[curr_pos] - right._digits[curr_pos] + NUM_BASE;
-            result._digits[curr_pos + 1] -= 1;
-        } else {
-            result._digits[curr_pos] = result._digits[curr_pos] - right._digits[curr_pos];
+    int64_t borrow = 0;
+    for (int curr_pos = 0; curr_pos < result._digits.size(); ++curr_pos) {
+        if (curr_pos >= right._digits.size() && borrow == 0) {
+            break;
         }
-    }
-    if (left._digits.size() > right._digits.size()) {
-        if (result._digits[right._digits.size()] < 0) {
-            result._digits[right._digits.size()] += NUM_BASE;
-            result._digits[right._digits.size() + 1] -= 1;
+        result._digits[curr_pos] -= borrow;
+        if (curr_pos < right._digits.size()) {
+            result._digits[curr_pos] -= right._digits[curr_pos];
         }
+        borrow = result._digits[curr_pos] < 0 ? 1 : 0;
+        result._digits[curr_pos] += borrow * NUM_BASE;
     }
     while (!result._digits.empty() && (result._digits.back() == 0)) {
        result. _digits.pop_back();
@@ -216,180 +212,182 @@ BigNum operator*(const BigNum &left, int right) {
     } else {
         result._digits.push_back(addition);
     }
-    while (!result._digits.empty() && result._digits.back() == 0)
+    while (result._digits.size() > 1 && result._digits.back() == 0)
         result._digits.pop_back();
     return result;
 }
 
+namespace {
 /**
- * @brief Compares vector of digits with operator <
- * @param step points to the number of digits from beginning of left var to compare
+ * @brief Drops leading zero cells, keeps a single zero cell for 0
  */
-bool isLowerDigits(const std::vector<char> &left, const std::vector<char> &right, int step) {
-    if ((step > right.size()) && (step <= left.size())) return false;
-    if ((step < right.size()) || (left.size() < right.size())) return true;
-    if (step > left.size()) return true;
-    for (int i = right.size() - 1; i >= 0; --i) {
-        if (left[left.size() + i - step] < right[i]) return true;
-        if (left[left.size() + i - step] > right[i]) return false;
+void trim(std::vector<int64_t>& digits) {
+    while (digits.size() > 1 && digits.back() == 0) {
+        digits.pop_back();
     }
-    return false;
-}
-
-bool isLowerDigits(const std::vector<char> &left, const std::vector<char> &right, int step);
-
-auto addDigits(const std::vector <char> &lhs, const std::vector <char> &rhs) {
-
-    constexpr auto BASE = 10;
-    std::vector <char> result;
-
-
-    if (isLowerDigits(lhs, rhs, 0)) {
-        result = rhs;
-        int addition{};
-        for (std::size_t i = 0; i < rhs.size(); ++i) {
-            result[i] += (i >= lhs.size()) ? addition : lhs[i] + addition;
-            addition = result[i] / BASE;
-            result[i] %= BASE;
-        }
-    } else {
-        result = lhs;
-        int addition{};
-        for (std::size_t i = 0; i < rhs.size(); ++i) {
-            result[i] += (i >= rhs.size()) ? addition : rhs[i] + addition;
-            addition = result[i] / BASE;
-            result[i] %= BASE;
-        }
+    if (digits.empty()) {
+        digits.push_back(0);
     }
-    return result;
 }
 
 /**
- * @brief Multiplies vector of digits and int
+ * @brief Divides digits by 2^shift in place in one pass from the highest cell
+ * @param shift at most 9, so that NUM_BASE = 2^9 * 5^9 keeps every step exact in int64_t
+ * @return Remainder, the lowest shift bits
  */
-std::vector<char> multiplyDigits(std::vector<char> &num1, int num2) {
-    std::vector<char> result = num1;
-    int addition = 0;
-    for (int curr_pos = 0; curr_pos < result.size(); ++curr_pos) {
-        long long temp = result[curr_pos] * num2 + addition;
-        result[curr_pos] = temp % 10;
-        addition = temp / 10;
+int64_t shiftRight(std::vector<int64_t>& digits, int shift) {
+    const int64_t divisor = int64_t{1} << shift;
+    int64_t rest = 0;
+    for (int i = digits.size() - 1; i >= 0; --i) {
+        const int64_t current = rest * NUM_BASE + digits[i];
+        digits[i] = current >> shift;
+        rest = current & (divisor - 1);
     }
-    if (addition != 0) {
-        result.push_back(addition);
-    }
-    return result;
+    trim(digits);
+    return rest;
 }
+} // <anonymous> namespace
 
-/**
- * @brief Returns power of basis to make two numbers almost equal
- * @param fnum number to reach
- * @param snum number to multiply
- * @return Maximum power of basis to reach bottom border of fnum
- */
-int getMaxPow(std::vector<char> &fnum, std::vector<char> &snum)
-{
-    if (snum.size() > fnum.size()) {
-        return -1;
+/// every cell of right is read before the same cell of left is written, so left and right may be one number
+BigNum& operator+=(BigNum& left, const BigNum& right) {
+    const int right_size = right._digits.size();
+    if (left._digits.size() < right_size) {
+        left._digits.resize(right_size, 0);
     }
-    int current_pow = fnum.size() - snum.size();
-    for (int i = snum.size() - 1; i >= 0; --i) {
-        if (snum[i] > fnum[i + current_pow]) {
-            return current_pow - 1;
-        }
-        if (snum[i] < fnum[i + current_pow]) {
-            return current_pow;
+    int64_t addition = 0;
+    for (int curr_pos = 0; curr_pos < left._digits.size(); ++curr_pos) {
+        if (curr_pos >= right_size && addition == 0) {
+            break;
         }
+        const int64_t current = left._digits[curr_pos] + addition + (curr_pos < right_size ? right._digits[curr_pos] : 0);
+        addition = current / NUM_BASE;
+        left._digits[curr_pos] = current % NUM_BASE;
     }
-    return current_pow;
+    if (addition != 0) {
+        left._digits.push_back(addition);
+    }
+    return left;
 }
 
-/// TODO fix +=10 after changing basis
-/**
- * @brief Subtracts two numbers, where second one is multiplied on basis with given power.
- *        Result stores in first parameter
- * @param curr_pow power of basis
- */
-void subtractPow(std::vector<char> &fnum, std::vector<char> &snum, int curr_pow)
-{
-    for (int i = 0; i < snum.size(); ++i) {
-        if (fnum[i + curr_pow] < snum[i]) {
-            fnum[i + curr_pow] += 10;
-            fnum[i + curr_pow + 1] -= 1;
+BigNum& operator-=(BigNum& left, const BigNum& right) {
+    const int right_size = right._digits.size();
+    int64_t borrow = 0;
+    for (int curr_pos = 0; curr_pos < left._digits.size(); ++curr_pos) {
+        if (curr_pos >= right_size && borrow == 0) {
+            break;
         }
-        fnum[i + curr_pow] -= snum[i];
+        int64_t current = left._digits[curr_pos] - borrow - (curr_pos < right_size ? right._digits[curr_pos] : 0);
+        borrow = current < 0 ? 1 : 0;
+        left._digits[curr_pos] = current + borrow * NUM_BASE;
     }
+    trim(left._digits);
+    return left;
 }
 
 /**
- * @brief Compares with operator<= two numbers, where second one is multiplied on basis with given power
- * @param curr_pow power of basis
+ * @brief Long division in NUM_BASE (Knuth, TAOCP vol. 2, 4.3.1, algorithm D)
  */
-bool lessNumPow(std::vector<char> &fnum, std::vector<char> &snum, int curr_pow)
-{
-    if (curr_pow + snum.size() < fnum.size()) {
-        return true;
-    }
-    for (int i = snum.size() - 1; i >= 0; --i) {
-        if (fnum[i + curr_pow] < snum[i]) {
-            return false;
-        }
-        if (fnum[i + curr_pow] > snum[i]) {
-            return true;
-        }
-    }
-    return true;
-}
-
 std::pair<BigNum, BigNum> extract(const BigNum &left, const BigNum &right) {
     if (left < right) {
         return std::pair<BigNum, BigNum>(0_bn, left);
     }
 
-    std::vector<char> fnum = toOneDigit(left);
-    std::vector<char> snum = toOneDigit(right);
-    std::vector<char> current = snum;
-    std::vector<char> result;
-    int curr_pow = getMaxPow(fnum, snum);
-    int hight_rank = 1;
-    while (true) {
-        while (lessNumPow(fnum, current, curr_pow)) {
-            ++hight_rank;
-            current = multiplyDigits(snum, hight_rank);
-        }
-        current = multiplyDigits(snum, hight_rank - 1);
-        subtractPow(fnum, current, curr_pow);
-        result.push_back(hight_rank-1);
-        int to_delete = current.size();
-        while (!fnum.empty() && (fnum.back() == 0) && (to_delete > 0)) {
-            fnum.pop_back();
-            --to_delete;
-        }
-        while (!fnum.empty() && (fnum.back() == 0)) {
-            fnum.pop_back();
-            --curr_pow;
-            result.push_back(0);
-        }
-        if ((fnum.size() <= curr_pow) && (curr_pow <= snum.size()) && !lessNumPow(fnum, snum, 0)) {
-            for (int i = 0; i < fnum.size(); i++) {
-                result.push_back(0);
+    auto divisor = right._digits;
+    trim(divisor);
+    if (divisor.size() == 1 && divisor[0] == 0) {
+        throw std::invalid_argument("Division by zero.");
+    }
+
+    auto dividend = left._digits;
+    trim(dividend);
+
+    BigNum quotient;
+    BigNum remainder;
+
+    if (divisor.size() == 1) {
+        quotient._digits.resize(dividend.size());
+        int64_t rest = 0;
+        for (int i = dividend.size() - 1; i >= 0; --i) {
+            const int64_t current = rest * NUM_BASE + dividend[i];
+            quotient._digits[i] = current / divisor[0];
+            rest = current % divisor[0];
+        }
+        trim(quotient._digits);
+        remainder._digits.push_back(rest);
+        return std::pair{quotient, remainder};
+    }
+
+    /// Normalize so that the top cell of the divisor is at least NUM_BASE / 2
+    const int64_t scale = NUM_BASE / (divisor.back() + 1);
+    const auto scaled = [scale](std::vector<int64_t>& digits) {
+        int64_t carry = 0;
+        for (auto& digit : digits) {
+            const int64_t current = digit * scale + carry;
+            digit = current % NUM_BASE;
+            carry = current / NUM_BASE;
+        }
+        digits.push_back(carry);
+    };
+    scaled(divisor);
+    divisor.pop_back();
+    scaled(dividend);
+
+    const int n = divisor.size();
+    const int m = dividend.size() - n - 1;
+    quotient._digits.assign(m + 1, 0);
+
+    for (int j = m; j >= 0; --j) {
+        const int64_t top = dividend[j + n] * NUM_BASE + dividend[j + n - 1];
+        int64_t q_hat = top / divisor[n - 1];
+        int64_t r_hat = top % divisor[n - 1];
+        while (q_hat >= NUM_BASE || q_hat * divisor[n - 2] > r_hat * NUM_BASE + dividend[j + n - 2]) {
+            --q_hat;
+            r_hat += divisor[n - 1];
+            if (r_hat >= NUM_BASE) {
+                break;
             }
         }
-        int new_pow = getMaxPow(fnum, snum);
-        if (new_pow == -1) {
-            break;
+
+        /// dividend[j .. j + n] -= q_hat * divisor
+        int64_t borrow = 0;
+        int64_t carry = 0;
+        for (int i = 0; i < n; ++i) {
+            const int64_t product = q_hat * divisor[i] + carry;
+            carry = product / NUM_BASE;
+            int64_t current = dividend[i + j] - product % NUM_BASE - borrow;
+            borrow = current < 0 ? 1 : 0;
+            dividend[i + j] = current + borrow * NUM_BASE;
         }
-        while (curr_pow != new_pow + 1) {
-            --curr_pow;
-            result.push_back(0);
+        int64_t current = dividend[j + n] - carry - borrow;
+        borrow = current < 0 ? 1 : 0;
+        dividend[j + n] = current + borrow * NUM_BASE;
+
+        /// q_hat was one too big, add divisor back
+        if (borrow != 0) {
+            --q_hat;
+            carry = 0;
+            for (int i = 0; i < n; ++i) {
+                const int64_t sum = dividend[i + j] + divisor[i] + carry;
+                dividend[i + j] = sum % NUM_BASE;
+                carry = sum / NUM_BASE;
+            }
+            dividend[j + n] = (dividend[j + n] + carry) % NUM_BASE;
         }
-        --curr_pow;
-        hight_rank = 1;
-        current = snum;
+        quotient._digits[j] = q_hat;
+    }
+
+    /// Remainder is the low part of the dividend divided back by scale
+    remainder._digits.assign(n, 0);
+    int64_t rest = 0;
+    for (int i = n - 1; i >= 0; --i) {
+        const int64_t current = rest * NUM_BASE + dividend[i];
+        remainder._digits[i] = current / scale;
+        rest = current % scale;
     }
 
-    std::reverse(result.begin(), result.end());
-    return std::pair{toBigNum(result), toBigNum(fnum)};
+    trim(quotient._digits);
+    trim(remainder._digits);
+    return std::pair{quotient, remainder};
 }
 
 void modify(BigNum& num, const BigNum& mod) {
@@ -480,6 +478,9 @@ namespace {
         for (int i = 0; i < lhs.size(); ++i) {
             for (int j = 0; j < rhs.size(); ++j) {
                 result[i + j] += lhs[i] * rhs[j];
+                /// carry right away, otherwise the column sums overflow int64_t
+                result[i + j + 1] += result[i + j] / NUM_BASE;
+                result[i + j] %= NUM_BASE;
             }
         }
 
@@ -521,10 +522,29 @@ namespace {
             rhsLR[i] = rhsL[i] + rhsR[i];
         }
 
+        /// sums are carried so cells stay below NUM_BASE and naive products can't overflow,
+        /// carries out of the halves (A + B = S + carry * NUM_BASE^(length / 2)) are added separately
+        const auto carrySum = [](std::vector<int64_t>& sum) {
+            int64_t carry = 0;
+            for (auto& cell : sum) {
+                cell += carry;
+                carry = cell / NUM_BASE;
+                cell %= NUM_BASE;
+            }
+            return carry;
+        };
+        const int64_t lhs_carry = carrySum(lhsLR);
+        const int64_t rhs_carry = carrySum(rhsLR);
+
         auto c3 = karatsuba(
             ArrayView<int64_t>{lhsLR.begin(), lhsLR.end()},
             ArrayView<int64_t>{rhsLR.begin(), rhsLR.end()}
         );
+        c3.resize(length + 1);
+        for (auto i = 0; i < length / 2; ++i) {
+            c3[i + length / 2] += lhs_carry * rhsLR[i] + rhs_carry * lhsLR[i];
+        }
+        c3[length] += lhs_carry * rhs_carry;
 
         for (auto i = 0; i < length; ++i){
             c3[i] -= c2[i] + c1[i];
@@ -538,7 +558,7 @@ namespace {
             result[i] = c1[i - length];
         }
 
-        for (auto i = length / 2; i < length + length / 2; ++i) {
+        for (auto i = length / 2; i <= length + length / 2; ++i) {
             result[i] += c3[i - length / 2];
         }
 
@@ -550,10 +570,16 @@ namespace {
      */
     inline void finalize(std::vector<int64_t>& num) {
         for (auto i = 0; i < num.size(); ++i) {
+            /// Karatsuba's middle term may leave negative cells, so carry is floored
+            int64_t carry = num[i] / NUM_BASE;
+            num[i] %= NUM_BASE;
+            if (num[i] < 0) {
+                num[i] += NUM_BASE;
+                --carry;
+            }
             if (i != num.size() - 1) {
-                num[i + 1] += num[i] / NUM_BASE;
+                num[i + 1] += carry;
             }
-            num[i] %= NUM_BASE;
         }
     }
 
@@ -617,7 +643,7 @@ BigNum operator*(const BigNum& lhs, const BigNum& rhs) {
 
     finalize(nums);
 
-    while (!nums.empty() && nums.back() == 0) {
+    while (nums.size() > 1 && nums.back() == 0) {
         nums.pop_back();
     }
 
@@ -658,74 +684,208 @@ BigNum inverted(const BigNum& num,
     }
 }
 
+std::vector<BigNum> invertedBatch(const std::vector<BigNum>& nums, const BigNum& mod) {
+    if (nums.empty()) {
+        return {};
+    }
+
+    /// prefix[i] = nums[0] * ... * nums[i]
+    std::vector<BigNum> prefix = { nums[0] % mod };
+    for (int i = 1; i < nums.size(); ++i) {
+        prefix.push_back(multiply(prefix.back(), nums[i], mod));
+    }
+
+    /// walking back, inverse holds (nums[0] * ... * nums[i])^(-1)
+    BigNum inverse = inverted(prefix.back(), mod, BigNum::InversionPolicy::Fermat);
+    std::vector<BigNum> result(nums.size());
+    for (int i = nums.size() - 1; i > 0; --i) {
+        result[i] = multiply(inverse, prefix[i - 1], mod);
+        inverse = multiply(inverse, nums[i], mod);
+    }
+    result[0] = inverse;
+    return result;
+}
+
 BigNum operator/(const BigNum& left, const BigNum& right) {
     return extract(left, right).first;
 }
 
+namespace {
+    /**
+     * @brief Tonelli–Shanks does about s^2 / 4 multiplications on top of an exponentiation,
+     *        Cipolla - about five exponentiations' worth, so it pays off when s^2 > 20 * log2(p)
+     */
+    constexpr int CIPOLLA_FACTOR = 20;
+}
+
+BigNum sqrtAtkin(const BigNum& n, const BigNum& p) {
+    /// v = (2n)^((p - 5) / 8), i = 2n * v^2, x = n * v * (i - 1)
+    const auto two_n = (n * 2) % p;
+    const auto v = powMontgomery(two_n, (p - 5_bn) / 8_bn, p);
+    const auto i = two_n * (v * v % p) % p;
+    return (n % p) * v % p * subtract(i, 1_bn, p) % p;
+}
+
+BigNum sqrtTonelliShanks(const BigNum& n, const BigNum& p, const BigNum& q, int s, const BigNum& c_start) {
+    // NOTE: Names of variables are taken directly from Wikipedia for better understanding
+    auto c = c_start;
+    auto r = powMontgomery(n, (q + 1_bn) / 2_bn, p);
+    auto t = powMontgomery(n, q, p);
+    auto m = s;
+
+    while (t != 1_bn) {
+        /// least i such that t^(2^i) = 1
+        auto i = 1;
+        for (auto x = t * t % p; x != 1_bn; x = x * x % p) {
+            ++i;
+        }
+
+        /// b = c^(2^(m - i - 1)) by repeated squaring
+        auto b = c;
+        for (auto j = 0; j < m - i - 1; ++j) {
+            b = b * b % p;
+        }
+
+        r = (r * b) % p;
+        c = (b * b) % p;
+        t = (t * c) % p;
+        m = i;
+    }
+
+    return r;
+}
+
+BigNum sqrtCipolla(const BigNum& n, const BigNum& p) {
+    /// a with non-residue w = a^2 - n, half of the candidates fit
+    auto a = 2_bn;
+    auto w = subtract(a * a, n, p);
+    while (jacobi(w, p) != -1) {
+        a = a + 1_bn;
+        if (a >= p) {
+            throw std::invalid_argument("No non-residue found, mod must be prime.");
+        }
+        w = subtract(a * a, n, p);
+    }
+
+    /// x + y * sqrt(w)
+    BigNum result_x = 1_bn;
+    BigNum result_y = 0_bn;
+    BigNum base_x = a;
+    BigNum base_y = 1_bn;
+
+    const auto times = [&](const BigNum& x1, const BigNum& y1, const BigNum& x2, const BigNum& y2) {
+        return std::pair{(x1 * x2 + (y1 * y2 % p) * w) % p, (x1 * y2 + x2 * y1) % p};
+    };
+
+    const auto bits = toBinary((p + 1_bn) / 2_bn);
+    for (int i = 0; i < bits.size(); ++i) {
+        if (bits[i] == 1) {
+            std::tie(result_x, result_y) = times(result_x, result_y, base_x, base_y);
+        }
+        if (i + 1 != bits.size()) {
+            std::tie(base_x, base_y) = times(base_x, base_y, base_x, base_y);
+        }
+    }
+
+    return result_x;
+}
+
+bool prefersCipolla(const BigNum& p, int s) {
+    return s * s > CIPOLLA_FACTOR * bitLength(p);
+}
+
+int jacobi(BigNum a, BigNum n) {
+    if (n._digits[0] % 2 == 0) {
+        throw std::invalid_argument("Jacobi symbol is defined for odd n only.");
+    }
+
+    /// NUM_BASE = 2^9 * 5^9, so residues modulo powers of two up to 2^9 come from the lowest cell
+    constexpr int BASE_TWOS = 9;
+    const auto mod8 = [](const BigNum& num) {
+        return num._digits[0] % 8;
+    };
+
+    a = a % n;
+    int result = 1;
+    while (a != 0_bn) {
+        /// a = 2^twos * odd, (2/n) = -1 iff n = 3, 5 (mod 8)
+        int twos = 0;
+        while (a._digits[0] % 2 == 0) {
+            int64_t low = a._digits[0];
+            int shift = 0;
+            while (shift < BASE_TWOS && low % 2 == 0) {
+                low /= 2;
+                ++shift;
+            }
+            shiftRight(a._digits, shift);
+            twos += shift;
+        }
+        if (twos % 2 == 1 && (mod8(n) == 3 || mod8(n) == 5)) {
+            result = -result;
+        }
+
+        /// quadratic reciprocity for odd a and n
+        std::swap(a, n);
+        if (mod8(a) % 4 == 3 && mod8(n) % 4 == 3) {
+            result = -result;
+        }
+        a = a % n;
+    }
+
+    return n == 1_bn ? result : 0;
+}
+
 std::optional<std::pair<BigNum, BigNum>> sqrt(const BigNum& n, const BigNum& p)
 {
-    // NOTE: Names of variables are taken directly from Wikipedia for better understanding
+    if (p == 2_bn) {
+        return std::pair{n % p, n % p};
+    }
 
-    /// If it doesn't satisfy Fermat's little theorem than we can't find result
-    if (pow(n, (p - 1_bn) / 2_bn, p) != 1_bn) {
+    /// Only quadratic residues modulo odd prime have roots. Jacobi symbol modulo odd perfect square
+    /// is never -1, so the searches for non-residues below would not end
+    if (p % 2_bn == 0_bn || isPerfectSquare(p) || jacobi(n, p) != 1) {
         return {};
     }
 
-    /// Attempt to find trivial solution
+    /// p - 1 = q * 2^s
     const auto& [q, s] = [&] {
         auto q = p - 1_bn;
-        auto s = 0_bn;
+        auto s = 0;
         while (q % 2_bn == 0_bn) {
             q = q / 2_bn;
-            s = s + 1_bn;
+            ++s;
         }
 
         return std::pair{q, s};
     }();
 
     /// If p = 3 (mod 4) than solutions are trivial
-    if (s == 1_bn) {
+    if (s == 1) {
         const auto x = pow(n, (p + 1_bn) / 4_bn, p);
         return std::pair{x, p - x};
     }
 
-    /// Select a quadric non-residue (mod p)
-    const auto z = [&] {
-        for (auto i = 1_bn; i < p; i = i + 1_bn) {
-            if (pow(i, (p - 1_bn) / 2_bn, p) != 1_bn) {
-                return i;
-            }
-        }
-
-        return 0_bn;
-    }();
-
-    auto c = pow(z, q, p);
-    auto r = pow(n, (q + 1_bn) / 2_bn, p);
-    auto t = pow(n, q, p);
-    auto m = s;
-
-    while (t != 1_bn) {
-        const auto& [i, x] = [&] {
-            auto i = 1_bn;
-            auto x = t * t % p;
-            while (x != 1_bn) {
-                x = x * x % p;
-                i = i + 1_bn;
-            }
+    /// If p = 5 (mod 8) than Atkin's formula works
+    if (s == 2) {
+        const auto x = sqrtAtkin(n, p);
+        return std::pair{x, p - x};
+    }
 
-            return std::pair(i, x);
-        }();
-        
-        const auto b = pow(c, pow(2_bn, (m - i - 1_bn), p), p);
+    if (prefersCipolla(p, s)) {
+        const auto x = sqrtCipolla(n, p);
+        return std::pair{x, p - x};
+    }
 
-        r = (r * b) % p;
-        c = (b * b) % p;
-        t = (t * c) % p;
-        m = i;
+    /// Quadratic non-residue (mod p) for Tonelli–Shanks
+    auto z = 2_bn;
+    while (jacobi(z, p) != -1) {
+        z = z + 1_bn;
+        if (z >= p) {
+            return {};
+        }
     }
-    
-    return std::pair{r, p - r};
+    const auto x = sqrtTonelliShanks(n, p, q, s, powMontgomery(z, q, p));
+    return std::pair{x, p - x};
 }
 
 int countDigit(long long n) {
@@ -777,79 +937,447 @@ BigNum multiplyMontgomery(const BigNum& left, const BigNum& right, const BigNum&
 }
 
 BigNum powMontgomery(const BigNum& base, BigNum degree, const BigNum& mod) {
-    BigNum montgomery_coefficient = calculateMontgomeryCoefficient(mod);
-    BigNum mc_inverted = inverted(montgomery_coefficient, mod, BigNum::InversionPolicy::Euclid);
-    BigNum coefficient = extract(montgomery_coefficient * mc_inverted - 1_bn, mod).first;
-    std::pair<BigNum, BigNum> extraction;
-    BigNum base_mf = convertToMontgomeryForm(base, mod, montgomery_coefficient);
-    BigNum result = convertToMontgomeryForm(1_bn,mod,montgomery_coefficient);
-    while(degree > 0_bn) {
-        extraction = extract(degree, 2_bn);
-        if(extraction.second == 1_bn) {
-            result = multiplyMontgomery(result, base_mf, mod, montgomery_coefficient, coefficient);
-        }
-        degree = extraction.first;
-        base_mf = multiplyMontgomery(base_mf, base_mf, mod, montgomery_coefficient, coefficient);
-    }
-    result = multiply(result, mc_inverted, mod);
+    if (mod._digits[0] % 2 != 0 && mod._digits[0] % 5 != 0) {
+        return MontgomeryContext(mod).pow(base, degree);
+    }
+
+    /// MontgomeryContext needs mod coprime with NUM_BASE, others get plain square-and-multiply
+    BigNum result = 1_bn % mod;
+    const BigNum reduced = base % mod;
+    const auto bits = toBinary(degree);
+    for (auto bit = bits.rbegin(); bit != bits.rend(); ++bit) {
+        result = multiply(result, result, mod);
+        if (*bit == 1) {
+            result = multiply(result, reduced, mod);
+        }
+    }
     return result;
 }
 
-BigNum sqrt(const BigNum& num) {
-    if (num == 1_bn) {
-        return 1_bn;
+std::vector<char> toBinary(const BigNum& num) {
+    std::vector<char> bits;
+    auto digits = num._digits;
+    trim(digits);
+    while (!(digits.size() == 1 && digits[0] == 0)) {
+        bits.push_back(shiftRight(digits, 1));
+    }
+    return bits;
+}
+
+int bitLength(const BigNum& num) {
+    return toBinary(num).size();
+}
+
+std::vector<uint8_t> toBytes(const BigNum& num, int length) {
+    std::vector<uint8_t> bytes(length, 0);
+    auto digits = num._digits;
+    trim(digits);
+    for (int i = length - 1; i >= 0; --i) {
+        int64_t rest = 0;
+        for (int j = digits.size() - 1; j >= 0; --j) {
+            const int64_t current = rest * NUM_BASE + digits[j];
+            digits[j] = current / 256;
+            rest = current % 256;
+        }
+        bytes[i] = rest;
+        trim(digits);
+    }
+    if (!(digits.size() == 1 && digits[0] == 0)) {
+        throw std::invalid_argument("Number doesn't fit given length.");
+    }
+    return bytes;
+}
+
+BigNum fromBytes(const std::vector<uint8_t>& bytes) {
+    BigNum result = 0_bn;
+    for (const auto byte : bytes) {
+        result = result * 256 + BigNum(std::to_string(byte));
+    }
+    return result;
+}
+
+int cellCount(const BigNum& num) {
+    auto digits = num._digits;
+    trim(digits);
+    return digits.size();
+}
+
+BigNum pack(const std::vector<BigNum>& nums, int slot) {
+    BigNum result;
+    result._digits.assign(std::max<size_t>(nums.size() * slot, 1), 0);
+    for (int i = 0; i < nums.size(); ++i) {
+        if (cellCount(nums[i]) > slot) {
+            throw std::invalid_argument("Number doesn't fit given slot.");
+        }
+        std::copy(nums[i]._digits.begin(), nums[i]._digits.begin() + cellCount(nums[i]),
+                  result._digits.begin() + i * slot);
+    }
+    trim(result._digits);
+    return result;
+}
+
+std::vector<BigNum> unpack(const BigNum& num, int slot, int count) {
+    std::vector<BigNum> result(count);
+    for (int i = 0; i < count; ++i) {
+        const int from = std::min<int>(i * slot, num._digits.size());
+        const int to = std::min<int>(from + slot, num._digits.size());
+        result[i]._digits.assign(num._digits.begin() + from, num._digits.begin() + to);
+        trim(result[i]._digits);
     }
+    return result;
+}
 
-    BigNum res = num / 2_bn;
-    BigNum left = 0_bn, right = num;
+std::size_t hashValue(const BigNum& num) noexcept {
+    /// numbers may keep leading zero cells, they must not change the hash
+    std::size_t size = num._digits.size();
+    while (size > 1 && num._digits[size - 1] == 0) {
+        --size;
+    }
+    std::size_t seed = size;
+    for (std::size_t i = 0; i < size; ++i) {
+        seed ^= std::hash<int64_t>{}(num._digits[i]) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+}
 
-    while(true) {
-        BigNum sqr = res * res;
-        BigNum res_plus = res + 1_bn;
-        BigNum res_minus = res - 1_bn;
+namespace {
+/**
+ * @return Number made of bits [from, from + width) of bits
+ */
+int windowValue(const std::vector<char>& bits, int from, int width) {
+    int value = 0;
+    for (int bit = std::min<int>(bits.size(), from + width) - 1; bit >= from; --bit) {
+        value = value * 2 + bits[bit];
+    }
+    return value;
+}
+
+/**
+ * @brief Number of bases from which multiExp switches from Straus to Pippenger
+ */
+constexpr int MIN_FOR_PIPPENGER = 16;
+} // <anonymous> namespace
+
+MontgomeryContext::MontgomeryContext(const BigNum& mod)
+    : _mod(mod), _cells(cellCount(mod))
+{
+    if (_mod._digits[0] % 2 == 0 || _mod._digits[0] % 5 == 0) {
+        throw std::invalid_argument("Montgomery form needs mod coprime with NUM_BASE.");
+    }
 
-        if (sqr == num) {
-            return res;
+    /// inverse of the lowest cell modulo NUM_BASE by extended Euclid
+    int64_t r_prev = NUM_BASE, r = _mod._digits[0] % NUM_BASE;
+    int64_t t_prev = 0, t = 1;
+    while (r != 0) {
+        const int64_t q = r_prev / r;
+        r_prev = std::exchange(r, r_prev - q * r);
+        t_prev = std::exchange(t, t_prev - q * t);
+    }
+    const int64_t inverse = (t_prev % NUM_BASE + NUM_BASE) % NUM_BASE;
+    _mod_inverse = (NUM_BASE - inverse) % NUM_BASE;
+
+    BigNum r_power;
+    r_power._digits.assign(_cells + 1, 0);
+    r_power._digits.back() = 1;
+    _one = r_power % _mod;
+    _r_squared = lab::multiply(_one, _one, _mod);
+}
+
+BigNum MontgomeryContext::_redc(const BigNum& left, const BigNum& right) const {
+    const int n = _cells;
+    const auto cell = [](const BigNum& num, int i) -> int64_t {
+        return i < num._digits.size() ? num._digits[i] : 0;
+    };
+
+    /// t stays below 2 * mod, cells stay below NUM_BASE, so every step fits int64_t
+    std::vector<int64_t> t(n + 2, 0);
+    for (int i = 0; i < n; ++i) {
+        const int64_t a = cell(left, i);
+        int64_t carry = 0;
+        for (int j = 0; j < n; ++j) {
+            const int64_t current = t[j] + a * cell(right, j) + carry;
+            t[j] = current % NUM_BASE;
+            carry = current / NUM_BASE;
         }
+        int64_t current = t[n] + carry;
+        t[n] = current % NUM_BASE;
+        t[n + 1] = current / NUM_BASE;
+
+        /// add m * mod, which zeroes the lowest cell, and shift by one cell
+        const int64_t m = t[0] * _mod_inverse % NUM_BASE;
+        carry = (t[0] + m * _mod._digits[0]) / NUM_BASE;
+        for (int j = 1; j < n; ++j) {
+            current = t[j] + m * _mod._digits[j] + carry;
+            t[j - 1] = current % NUM_BASE;
+            carry = current / NUM_BASE;
+        }
+        current = t[n] + carry;
+        t[n - 1] = current % NUM_BASE;
+        t[n] = t[n + 1] + current / NUM_BASE;
+    }
+
+    BigNum result;
+    t.pop_back();
+    trim(t);
+    result._digits = std::move(t);
+    if (result >= _mod) {
+        return result - _mod;
+    }
+    return result;
+}
+
+const BigNum& MontgomeryContext::modulo() const noexcept {
+    return _mod;
+}
+
+BigNum MontgomeryContext::toMontgomery(const BigNum& num) const {
+    return _redc(num < _mod ? num : num % _mod, _r_squared);
+}
+
+BigNum MontgomeryContext::fromMontgomery(const BigNum& num) const {
+    return _redc(num, 1_bn);
+}
 
-        if (sqr < num) {
-            if ((res_plus) * (res_plus) > num) {
-                return res;
+BigNum MontgomeryContext::multiply(const BigNum& left, const BigNum& right) const {
+    return _redc(left, right);
+}
+
+const BigNum& MontgomeryContext::one() const noexcept {
+    return _one;
+}
+
+BigNum MontgomeryContext::pow(const BigNum& base, const BigNum& degree) const {
+    BigNum base_mf = toMontgomery(base);
+    BigNum result = _one;
+    const auto bits = toBinary(degree);
+    for (int i = 0; i < bits.size(); ++i) {
+        if (bits[i] == 1) {
+            result = multiply(result, base_mf);
+        }
+        if (i + 1 != bits.size()) {
+            base_mf = multiply(base_mf, base_mf);
+        }
+    }
+    return fromMontgomery(result);
+}
+
+FixedBasePow::FixedBasePow(const BigNum& base, const BigNum& mod, int max_degree_bits, int window)
+    : _context(mod), _base(base), _window(window),
+      _max_degree_bits(max_degree_bits > 0 ? max_degree_bits : bitLength(mod))
+{
+    if (window < 1) {
+        throw std::invalid_argument("Window must be positive.");
+    }
+
+    const int rows = (_max_degree_bits + window - 1) / window;
+    const int row_size = (1 << window) - 1;
+    _table.resize(rows);
+
+    /// base^(2^(window * i)) in Montgomery form
+    BigNum row_base = _context.toMontgomery(base);
+    for (int i = 0; i < rows; ++i) {
+        _table[i].reserve(row_size);
+        _table[i].push_back(row_base);
+        for (int d = 2; d <= row_size; ++d) {
+            _table[i].push_back(_context.multiply(_table[i].back(), row_base));
+        }
+        row_base = _context.multiply(_table[i].back(), row_base);
+    }
+}
+
+BigNum FixedBasePow::pow(const BigNum& degree) const {
+    const auto bits = toBinary(degree);
+    if (bits.size() > _max_degree_bits) {
+        return _context.pow(_base, degree);
+    }
+
+    BigNum result = _context.one();
+    for (int i = 0; i * _window < bits.size(); ++i) {
+        const int value = windowValue(bits, i * _window, _window);
+        if (value != 0) {
+            result = _context.multiply(result, _table[i][value - 1]);
+        }
+    }
+    return _context.fromMontgomery(result);
+}
+
+const BigNum& FixedBasePow::base() const noexcept {
+    return _base;
+}
+
+const BigNum& FixedBasePow::modulo() const noexcept {
+    return _context.modulo();
+}
+
+BigNum multiExp(const std::vector<BigNum>& bases, const std::vector<BigNum>& degrees, const BigNum& mod) {
+    if (bases.size() != degrees.size()) {
+        throw std::invalid_argument("Every base needs its degree.");
+    }
+
+    const MontgomeryContext context(mod);
+    std::vector<std::vector<char>> bits;
+    int max_bits = 0;
+    for (const auto& degree : degrees) {
+        bits.push_back(toBinary(degree));
+        max_bits = std::max<int>(max_bits, bits.back().size());
+    }
+
+    BigNum result = context.one();
+
+    if (bases.size() < MIN_FOR_PIPPENGER) {
+        /// Straus: table of base^1 .. base^(2^window - 1) for every base
+        const int window = max_bits > 64 ? 4 : 2;
+        std::vector<std::vector<BigNum>> tables(bases.size());
+        for (int i = 0; i < bases.size(); ++i) {
+            tables[i].push_back(context.toMontgomery(bases[i]));
+            for (int d = 2; d < (1 << window); ++d) {
+                tables[i].push_back(context.multiply(tables[i].back(), tables[i][0]));
             }
+        }
 
-            left = res;
-            try {
-                res = (right + left) * 2 / 4_bn;
-            } catch(std::exception& e) {
-                std::cout << left << std::endl << right << std::endl << std::endl;
+        for (int from = (max_bits - 1) / window * window; from >= 0; from -= window) {
+            for (int j = 0; j < window && result != context.one(); ++j) {
+                result = context.multiply(result, result);
+            }
+            for (int i = 0; i < bases.size(); ++i) {
+                const int value = windowValue(bits[i], from, window);
+                if (value != 0) {
+                    result = context.multiply(result, tables[i][value - 1]);
+                }
             }
+        }
+    } else {
+        /// Pippenger: bases with the same window value share a bucket
+        const int window = std::max(2, static_cast<int>(std::log2(bases.size())) - 1);
+        std::vector<BigNum> bases_mf;
+        for (const auto& base : bases) {
+            bases_mf.push_back(context.toMontgomery(base));
+        }
 
-        } else {
-            if ((res_minus) * (res_minus) < num) {
-                return res_minus;
+        for (int from = (max_bits - 1) / window * window; from >= 0; from -= window) {
+            for (int j = 0; j < window && result != context.one(); ++j) {
+                result = context.multiply(result, result);
             }
-            right = res;
-            try {
-                res = (right + left) * 2 / 4_bn;
-            } catch(std::exception& e) {
-                std::cout << left << std::endl << right << std::endl << std::endl;
+
+            std::vector<std::optional<BigNum>> buckets((1 << window) - 1);
+            for (int i = 0; i < bases.size(); ++i) {
+                const int value = windowValue(bits[i], from, window);
+                if (value != 0) {
+                    auto& bucket = buckets[value - 1];
+                    bucket = bucket ? context.multiply(*bucket, bases_mf[i]) : bases_mf[i];
+                }
             }
+
+            /// product of bucket[d]^d as running products from the biggest d
+            std::optional<BigNum> running;
+            std::optional<BigNum> window_product;
+            for (int d = buckets.size() - 1; d >= 0; --d) {
+                if (buckets[d]) {
+                    running = running ? context.multiply(*running, *buckets[d]) : *buckets[d];
+                }
+                if (running) {
+                    window_product = window_product ? context.multiply(*window_product, *running) : *running;
+                }
+            }
+            if (window_product) {
+                result = context.multiply(result, *window_product);
+            }
+        }
+    }
+
+    return context.fromMontgomery(result);
+}
+
+namespace {
+    /**
+     * @return 2^power
+     */
+    BigNum powerOfTwo(int power) {
+        BigNum result = 1_bn;
+        for (; power >= 16; power -= 16) {
+            result = result * (1 << 16);
+        }
+        return result * (1 << power);
+    }
+}
+
+BigNum isqrt(const BigNum& num) {
+    return iroot(num, 2);
+}
+
+BigNum iroot(const BigNum& num, int k) {
+    if (k < 1) {
+        throw std::invalid_argument("Root degree must be positive.");
+    }
+    if (num == 0_bn || k == 1) {
+        return num;
+    }
+
+    /// 2^ceil(bits / k) is not less than the root, so Newton's steps decrease monotonically to it
+    const int bits = bitLength(num);
+    BigNum x = powerOfTwo((bits + k - 1) / k);
+    const BigNum k_num(std::to_string(k));
+
+    while (true) {
+        BigNum x_power = 1_bn;
+        for (int i = 1; i < k; ++i) {
+            x_power = x_power * x;
+        }
+        /// x' = ((k - 1) * x + num / x^(k - 1)) / k
+        const BigNum next = (x * (k - 1) + num / x_power) / k_num;
+        if (next >= x) {
+            return x;
+        }
+        x = next;
+    }
+}
+
+bool isPerfectSquare(const BigNum& num) {
+    /// 2^6 divides NUM_BASE, 45045 = 63 * 65 * 11
+    const int residue64 = num._digits[0] % 64;
+    const int residue = std::stoi(to_string(num % 45045_bn));
+    /// together these filters reject all but ~1% of non-squares
+    static const auto filters = [] {
+        std::vector<std::pair<int, std::vector<bool>>> filters;
+        for (const int mod : {64, 63, 65, 11}) {
+            std::vector<bool> squares(mod);
+            for (int i = 0; i < mod; ++i) {
+                squares[i * i % mod] = true;
+            }
+            filters.emplace_back(mod, std::move(squares));
+        }
+        return filters;
+    }();
+
+    for (const auto& [mod, squares] : filters) {
+        if (!squares[mod == 64 ? residue64 : residue % mod]) {
+            return false;
         }
     }
+
+    const auto root = isqrt(num);
+    return root * root == num;
+}
+
+BigNum sqrt(const BigNum& num) {
+    return isqrt(num);
 }
 
 BigNum logStep(const BigNum& num, const BigNum& base, const BigNum& mod) {
     if (num == 1_bn) {
         return 0_bn;
     }
-    BigNum sqrt_mod = sqrt(mod);
+    BigNum sqrt_mod = isqrt(mod);
     if (sqrt_mod * sqrt_mod != mod) {
         sqrt_mod = sqrt_mod + 1_bn;
     }
 
+    /// baby steps are consecutive powers, so each one is a single multiplication
     std::map<BigNum, BigNum> base_powers;
+    BigNum base_power = 1_bn;
     for (BigNum i = 0_bn; i < sqrt_mod; i = i + 1_bn) {
-        base_powers[powMontgomery(base, i, mod)] = i;
+        base_powers[base_power] = i;
+        base_power = multiply(base_power, base, mod);
     }
 
     //calculating the base in mod power to reduce the overall log calculating time
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <string_view>
+#include <functional>
 #include <algorithm>
 #include <optional>
 #include <iostream>
 #include <utility>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <cmath>
@@ -46,6 +48,12 @@ public:
     friend BigNum operator%(const BigNum& left, const BigNum& right);
     friend BigNum operator*(const BigNum& left, int right);
 
+    /**
+     * @brief In place versions reuse cells of left, for accumulating sums without allocations
+     */
+    friend BigNum& operator+=(BigNum& left, const BigNum& right);
+    friend BigNum& operator-=(BigNum& left, const BigNum& right);
+
     template<typename OStream>
     friend OStream& operator<<(OStream& os, const BigNum& num);
     template<typename IStream>
@@ -95,10 +103,50 @@ public:
     friend BigNum inverted(const BigNum& num, const BigNum& mod, InversionPolicy policy);
 
     /**
-     * @brief Finds square root of @a num modulo @a mod using Tonelli–Shanks algorithm
+     * @brief Inverts all nums modulo prime mod at once (Montgomery's trick):
+     *        one inversion and 3 * (n - 1) multiplications instead of n inversions
+     * @param nums must be non zero modulo mod
+     */
+    friend std::vector<BigNum> invertedBatch(const std::vector<BigNum>& nums, const BigNum& mod);
+
+    /**
+     * @brief Finds square root of @a num modulo prime @a mod using closed formulas for mod = 3 (mod 4)
+     *        and mod = 5 (mod 8), Cipolla's algorithm for big 2-adic valuation of mod - 1, Tonelli–Shanks otherwise
      */
     friend std::optional<std::pair<BigNum, BigNum>> sqrt(const BigNum& num, const BigNum& mod);
 
+    /**
+     * @brief Algorithms behind sqrt(num, mod), shared with Field::sqrt. Each returns one root
+     *        of quadratic residue num modulo odd prime mod
+     * @note sqrtAtkin needs mod = 5 (mod 8)
+     */
+    friend BigNum sqrtAtkin(const BigNum& num, const BigNum& mod);
+
+    /**
+     * @param odd_part and two_adicity come from mod - 1 = odd_part * 2^two_adicity
+     * @param non_residue_power is z^odd_part for quadratic non-residue z
+     */
+    friend BigNum sqrtTonelliShanks(const BigNum& num, const BigNum& mod, const BigNum& odd_part, int two_adicity,
+                                    const BigNum& non_residue_power);
+
+    /**
+     * @throws std::invalid_argument if no a < mod gives non-residue a^2 - num, possible for composite mod only
+     */
+    friend BigNum sqrtCipolla(const BigNum& num, const BigNum& mod);
+
+    /**
+     * @return True if Cipolla's algorithm beats Tonelli–Shanks for mod with given 2-adic valuation of mod - 1
+     */
+    friend bool prefersCipolla(const BigNum& mod, int two_adicity);
+
+    /**
+     * @brief Jacobi symbol (a/n) by binary reciprocity, without multiplications.
+     *        For prime n it is the Legendre symbol: 1 for quadratic residues, -1 for non-residues
+     * @param n must be odd
+     * @return 1, -1 or 0 if gcd(a, n) != 1
+     */
+    friend int jacobi(BigNum a, BigNum n);
+
     /**
      * @brief Converts number to vector of its digits
      * @return Vector of digits
@@ -135,14 +183,38 @@ public:
     /**
      * @brief raises BigNum to the BigNum power using modular exponentiation and Montgomery form
      * @param montgomery_coefficient = coprime and > mod
-     * @param mod should be prime, but not obliged to
+     * @param mod should be prime, but not obliged to. If it shares a factor with NUM_BASE
+     *        (is divisible by 2 or 5), plain square-and-multiply is used
      */
     friend BigNum powMontgomery(const BigNum& base, BigNum degree, const BigNum& mod);
 
-    /*
-     * @brief Finds square root of num*/
+    /**
+     * @brief Calculates product of bases[i]^degrees[i] modulo mod sharing squarings between all terms:
+     *        interleaved windows (Straus) for a few bases, buckets (Pippenger) for many
+     * @param bases and degrees must be of the same size
+     */
+    friend BigNum multiExp(const std::vector<BigNum>& bases, const std::vector<BigNum>& degrees, const BigNum& mod);
+
+    /**
+     * @brief Finds integer square root of num, same as isqrt
+     */
     friend BigNum sqrt(const BigNum& num);
 
+    /**
+     * @brief Finds floor of square root of num by Newton's method
+     */
+    friend BigNum isqrt(const BigNum& num);
+
+    /**
+     * @brief Finds floor of k-th root of num by Newton's method starting from 2^ceil(bits / k)
+     */
+    friend BigNum iroot(const BigNum& num, int k);
+
+    /**
+     * @brief Checks residues modulo 64, 63, 65 and 11 before computing isqrt
+     */
+    friend bool isPerfectSquare(const BigNum& num);
+
     /* @brief Finds log with given base and num
      * */
     friend BigNum logStep(const BigNum&, const BigNum&, const BigNum&);
@@ -178,11 +250,62 @@ public:
       * */
      friend std::vector<std::pair<BigNum, BigNum>> factorization(BigNum num);
 
+    /**
+     * @brief Converts number to vector of its bits
+     * @return Vector of bits, the least significant first, empty for 0
+     */
+    friend std::vector<char> toBinary(const BigNum& num);
+
+    /**
+     * @return Number of bits in binary representation of num, 0 for 0
+     */
+    friend int bitLength(const BigNum& num);
+
+    /**
+     * @brief Big-endian bytes of num, padded with zeros to length
+     * @throws std::invalid_argument if num doesn't fit length bytes
+     */
+    friend std::vector<uint8_t> toBytes(const BigNum& num, int length);
+
+    /**
+     * @brief Number from its big-endian bytes
+     */
+    friend BigNum fromBytes(const std::vector<uint8_t>& bytes);
+
+    /**
+     * @return Number of base NUM_BASE cells in representation of num
+     */
+    friend int cellCount(const BigNum& num);
+
+    /**
+     * @brief Kronecker substitution: sum of nums[i] * NUM_BASE^(slot * i), so product of packed
+     *        numbers packs products of polynomials while coefficients fit slot cells
+     * @throws std::invalid_argument if some num takes more than slot cells
+     */
+    friend BigNum pack(const std::vector<BigNum>& nums, int slot);
+
+    /**
+     * @brief Inverse of pack: count numbers of slot cells each, the lowest first
+     */
+    friend std::vector<BigNum> unpack(const BigNum& num, int slot, int count);
+
+    /**
+     * @brief Hash of the value, equal numbers have equal hashes; backs std::hash<BigNum>
+     */
+    friend std::size_t hashValue(const BigNum& num) noexcept;
+
+    /// reduces cell by cell
+    friend class MontgomeryContext;
+
 private:
     /// Array of coefficients in representation
     std::vector<int64_t> _digits;
 };
 
+/// Have no BigNum parameter, so they must be visible outside of ADL
+BigNum fromBytes(const std::vector<uint8_t>& bytes);
+BigNum pack(const std::vector<BigNum>& nums, int slot);
+
 template<typename OStream>
 OStream& operator<<(OStream& os, const BigNum& num)
 {
@@ -203,4 +326,101 @@ inline lab::BigNum operator""_bn(const char* str) {
     return lab::BigNum(str);
 }
 
+/**
+ * @brief Constants of Montgomery multiplication modulo fixed mod, calculated once instead of
+ *        on every call of powMontgomery. Unlike the free functions, R = NUM_BASE^(cells of mod),
+ *        so reduction works cell by cell (Montgomery's REDC) and never divides
+ */
+class MontgomeryContext
+{
+public:
+    explicit MontgomeryContext(const BigNum& mod);
+
+    const BigNum& modulo() const noexcept;
+
+    /**
+     * @return num * montgomery_coefficient % mod
+     */
+    BigNum toMontgomery(const BigNum& num) const;
+
+    /**
+     * @param num must be in Montgomery form
+     */
+    BigNum fromMontgomery(const BigNum& num) const;
+
+    /**
+     * @brief Multiplies two numbers in Montgomery form
+     * @param left and right must be below mod, they are not checked
+     */
+    BigNum multiply(const BigNum& left, const BigNum& right) const;
+
+    /**
+     * @return 1 in Montgomery form
+     */
+    const BigNum& one() const noexcept;
+
+    /**
+     * @brief Raises plain (not in Montgomery form) base to the power of degree modulo mod
+     */
+    BigNum pow(const BigNum& base, const BigNum& degree) const;
+
+private:
+    /**
+     * @return left * right / R % mod by interleaved multiplication and reduction (CIOS)
+     */
+    BigNum _redc(const BigNum& left, const BigNum& right) const;
+
+    BigNum _mod;
+    /// cells of mod, R = NUM_BASE^_cells
+    int _cells;
+    /// -mod^(-1) % NUM_BASE
+    int64_t _mod_inverse;
+    /// R^2 % mod
+    BigNum _r_squared;
+    BigNum _one;
+};
+
+/**
+ * @brief Exponentiation of a fixed base modulo fixed mod.
+ *        Keeps table base^(d * 2^(window * i)) for every window position i and window value d,
+ *        so pow() costs one multiplication per non zero window and no squarings.
+ * @note Object is immutable after construction, so it can be shared between threads
+ */
+class FixedBasePow
+{
+public:
+    /**
+     * @param max_degree_bits bit length of the biggest expected degree, bit length of mod if 0
+     * @param window bits per table row, every row holds 2^window - 1 numbers
+     */
+    FixedBasePow(const BigNum& base, const BigNum& mod, int max_degree_bits = 0, int window = 4);
+
+    /**
+     * @brief Raises base to the power of degree modulo mod
+     * @note Degrees longer than max_degree_bits fall back to plain square-and-multiply
+     */
+    BigNum pow(const BigNum& degree) const;
+
+    const BigNum& base() const noexcept;
+
+    const BigNum& modulo() const noexcept;
+
+private:
+    MontgomeryContext _context;
+    BigNum _base;
+    int _window;
+    int _max_degree_bits;
+    /// _table[i][d - 1] = base^(d * 2^(window * i)) in Montgomery form
+    std::vector<std::vector<BigNum>> _table;
+};
+
 } // namespace lab
+
+namespace std {
+template<>
+struct hash<lab::BigNum> {
+    std::size_t operator()(const lab::BigNum& num) const noexcept {
+        return hashValue(num);
+    }
+};
+} // namespace std
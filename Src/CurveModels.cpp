@@ -0,0 +1,318 @@
+#include <CurveModels.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace lab {
+
+namespace {
+/**
+ * @brief Montgomery curve equivalent to twisted Edwards curve: A = 2(a + d)/(a - d), B = 4/(a - d)
+ */
+MontgomeryCurve montgomeryOf(const std::shared_ptr<const Field>& f, const BigNum& a, const BigNum& d) {
+    const FieldElement a_element(*f, a);
+    const FieldElement d_element(*f, d);
+    if (a_element.isZero() || d_element.isZero() || a_element == d_element)
+        throw std::invalid_argument("Edwards curve needs non zero a and d, a != d.");
+
+    const FieldElement difference_inverse = (a_element - d_element).inverted();
+    const FieldElement two(*f, 2_bn);
+    return MontgomeryCurve(f, (two * (a_element + d_element) * difference_inverse).toBigNum(),
+                           (two.doubled() * difference_inverse).toBigNum());
+}
+} // <anonymous> namespace
+
+MontgomeryCurve::MontgomeryCurve(std::shared_ptr<const Field> f, const BigNum& a, const BigNum& b)
+    : _f(std::move(f)), _a(a), _b(b), _a_element(*_f, a), _b_element(*_f, b) {
+    const FieldElement two(*_f, 2_bn);
+    if (_b_element.isZero() || _a_element == two || _a_element == -two)
+        throw std::invalid_argument("Montgomery curve needs B != 0 and A != 2, -2.");
+
+    const FieldElement three(*_f, 3_bn);
+    const FieldElement three_inverse = three.inverted();
+    _a24 = (_a_element - two) * FieldElement(*_f, 4_bn).inverted();
+    _a_third = _a_element * three_inverse;
+    _b_inverse = _b_element.inverted();
+
+    ///a = (3 - A^2)/(3B^2), b = (2A^3 - 9A)/(27B^3) = A/3 * (2A^2 - 9) / (9B^3)
+    const FieldElement aa = _a_element.squared();
+    const FieldElement b_inverse2 = _b_inverse.squared();
+    const FieldElement weierstrass_a = (three - aa) * three_inverse * b_inverse2;
+    const FieldElement nine = three * three;
+    const FieldElement weierstrass_b = _a_third * (aa.doubled() - nine) * nine.inverted() * b_inverse2 * _b_inverse;
+    _weierstrass = EllipticCurve(_f, weierstrass_a.toBigNum(), weierstrass_b.toBigNum());
+}
+
+const std::shared_ptr<const Field>& MontgomeryCurve::getField() const {
+    return _f;
+}
+
+const BigNum& MontgomeryCurve::getA() const {
+    return _a;
+}
+
+const BigNum& MontgomeryCurve::getB() const {
+    return _b;
+}
+
+bool MontgomeryCurve::contains(const Point& p) const {
+    if (p == EllipticCurve::neutral)
+        return true;
+
+    ///B*v^2 == u^3 + A*u^2 + u = u*(u*(u + A) + 1)
+    const FieldElement u(*_f, p.x);
+    const FieldElement v(*_f, p.y);
+    return _b_element * v.squared() == u * (u * (u + _a_element) + FieldElement::one(*_f));
+}
+
+Point MontgomeryCurve::addPoints(const Point& first, const Point& second) const {
+    return fromWeierstrass(_weierstrass.addPoints(toWeierstrass(first), toWeierstrass(second)));
+}
+
+Point MontgomeryCurve::powerPoint(const Point& p, const BigNum& k) const {
+    return fromWeierstrass(_weierstrass.powerPoint(toWeierstrass(p), k));
+}
+
+BigNum MontgomeryCurve::ladder(const BigNum& u, const BigNum& k) const {
+    auto bits = toBinary(k);
+    bits.resize(std::max<int>(bits.size(), _f->bitLength()), 0);
+
+    const FieldElement x1(*_f, u);
+    FieldElement x2 = FieldElement::one(*_f);
+    FieldElement z2 = FieldElement::zero(*_f);
+    FieldElement x3 = x1;
+    FieldElement z3 = FieldElement::one(*_f);
+
+    ///(x2 : z2) = m * P, (x3 : z3) = (m + 1) * P, their difference is always P
+    for (int i = bits.size() - 1; i >= 0; --i) {
+        if (bits[i] == 1) {
+            std::swap(x2, x3);
+            std::swap(z2, z3);
+        }
+
+        const FieldElement a = x2 + z2;
+        const FieldElement aa = a.squared();
+        const FieldElement b = x2 - z2;
+        const FieldElement bb = b.squared();
+        const FieldElement e = aa - bb;
+        const FieldElement da = (x3 - z3) * a;
+        const FieldElement cb = (x3 + z3) * b;
+
+        ///differential addition: x = (DA + CB)^2, z = u * (DA - CB)^2
+        x3 = (da + cb).squared();
+        z3 = x1 * (da - cb).squared();
+
+        ///doubling: x = AA * BB, z = E * (AA + (A - 2)/4 * E)
+        x2 = aa * bb;
+        z2 = e * (aa + _a24 * e);
+
+        if (bits[i] == 1) {
+            std::swap(x2, x3);
+            std::swap(z2, z3);
+        }
+    }
+
+    if (z2.isZero())
+        return 0_bn;
+    return (x2 * z2.inverted()).toBigNum();
+}
+
+std::vector<uint8_t> MontgomeryCurve::encodeU(const BigNum& u) const {
+    auto bytes = toBytes(u, _f->byteLength());
+    std::reverse(bytes.begin(), bytes.end());
+    return bytes;
+}
+
+BigNum MontgomeryCurve::decodeU(const std::vector<uint8_t>& bytes) const {
+    if (bytes.size() != _f->byteLength())
+        throw std::invalid_argument("Encoded u must take bytes of modulo.");
+
+    std::vector<uint8_t> big_endian(bytes.rbegin(), bytes.rend());
+    if (const int used_bits = _f->bitLength() % 8; used_bits != 0)
+        big_endian[0] &= (1 << used_bits) - 1;
+    return _f->reduce(fromBytes(big_endian));
+}
+
+const EllipticCurve& MontgomeryCurve::weierstrass() const {
+    return _weierstrass;
+}
+
+Point MontgomeryCurve::toWeierstrass(const Point& p) const {
+    if (p == EllipticCurve::neutral)
+        return p;
+
+    ///x = (u + A/3)/B, y = v/B
+    const FieldElement x = (FieldElement(*_f, p.x) + _a_third) * _b_inverse;
+    const FieldElement y = FieldElement(*_f, p.y) * _b_inverse;
+    return { x.toBigNum(), y.toBigNum() };
+}
+
+Point MontgomeryCurve::fromWeierstrass(const Point& p) const {
+    if (p == EllipticCurve::neutral)
+        return p;
+
+    ///u = B*x - A/3, v = B*y
+    const FieldElement u = _b_element * FieldElement(*_f, p.x) - _a_third;
+    const FieldElement v = _b_element * FieldElement(*_f, p.y);
+    return { u.toBigNum(), v.toBigNum() };
+}
+
+EdwardsCurve::EdwardsCurve(std::shared_ptr<const Field> f, const BigNum& a, const BigNum& d)
+    : _f(std::move(f)), _a(a), _d(d), _a_element(*_f, a), _d_element(*_f, d),
+      _one(FieldElement::one(*_f)), _montgomery(montgomeryOf(_f, a, d))
+{}
+
+const std::shared_ptr<const Field>& EdwardsCurve::getField() const {
+    return _f;
+}
+
+const BigNum& EdwardsCurve::getA() const {
+    return _a;
+}
+
+const BigNum& EdwardsCurve::getD() const {
+    return _d;
+}
+
+bool EdwardsCurve::isComplete() const {
+    const BigNum& mod = _f->modulo();
+    return jacobi(_a % mod, mod) == 1 && jacobi(_d % mod, mod) == -1;
+}
+
+bool EdwardsCurve::contains(const Point& p) const {
+    ///a*x^2 + y^2 == 1 + d*x^2*y^2
+    const FieldElement xx = FieldElement(*_f, p.x).squared();
+    const FieldElement yy = FieldElement(*_f, p.y).squared();
+    return _a_element * xx + yy == _one + _d_element * xx * yy;
+}
+
+Point EdwardsCurve::invertedPoint(const Point& p) const {
+    return { (-FieldElement(*_f, p.x)).toBigNum(), p.y };
+}
+
+Point EdwardsCurve::addPoints(const Point& first, const Point& second) const {
+    const FieldElement x1(*_f, first.x);
+    const FieldElement y1(*_f, first.y);
+    const FieldElement x2(*_f, second.x);
+    const FieldElement y2(*_f, second.y);
+
+    const FieldElement x1x2 = x1 * x2;
+    const FieldElement y1y2 = y1 * y2;
+    const FieldElement t = _d_element * x1x2 * y1y2;
+    const FieldElement x_denominator = _one + t;
+    const FieldElement y_denominator = _one - t;
+    if (x_denominator.isZero() || y_denominator.isZero())
+        throw std::invalid_argument("Sum is at infinity, curve is not complete.");
+
+    const auto inverses = invertedBatch({ x_denominator, y_denominator });
+    const FieldElement x3 = (x1 * y2 + y1 * x2) * inverses[0];
+    const FieldElement y3 = (y1y2 - _a_element * x1x2) * inverses[1];
+    return { x3.toBigNum(), y3.toBigNum() };
+}
+
+EdwardsCurve::_ExtendedPoint EdwardsCurve::_addExtended(const _ExtendedPoint& first, const _ExtendedPoint& second) const {
+    ///add-2008-hwcd: A = X1*X2, B = Y1*Y2, C = d*T1*T2, D = Z1*Z2, E = (X1 + Y1)*(X2 + Y2) - A - B
+    const FieldElement a = first.x * second.x;
+    const FieldElement b = first.y * second.y;
+    const FieldElement c = _d_element * first.t * second.t;
+    const FieldElement d = first.z * second.z;
+    const FieldElement e = (first.x + first.y) * (second.x + second.y) - (a.lazy() + b).reduced();
+
+    ///F = D - C, G = D + C, H = B - a*A
+    const FieldElement f = d - c;
+    const FieldElement g = d + c;
+    const FieldElement h = b - _a_element * a;
+
+    ///X3 = E*F, Y3 = G*H, T3 = E*H, Z3 = F*G
+    return { e * f, g * h, f * g, e * h };
+}
+
+EdwardsCurve::_ExtendedPoint EdwardsCurve::_doubleExtended(const _ExtendedPoint& p) const {
+    ///dbl-2008-hwcd: A = X1^2, B = Y1^2, C = 2*Z1^2, D = a*A, E = (X1 + Y1)^2 - A - B
+    const FieldElement a = p.x.squared();
+    const FieldElement b = p.y.squared();
+    const FieldElement c = p.z.squared().doubled();
+    const FieldElement d = _a_element * a;
+    const FieldElement e = (p.x + p.y).squared() - (a.lazy() + b).reduced();
+
+    ///G = D + B, F = G - C, H = D - B
+    const FieldElement g = d + b;
+    const FieldElement f = g - c;
+    const FieldElement h = d - b;
+
+    ///X3 = E*F, Y3 = G*H, T3 = E*H, Z3 = F*G
+    return { e * f, g * h, f * g, e * h };
+}
+
+Point EdwardsCurve::powerPoint(const Point& p, const BigNum& k) const {
+    const FieldElement x(*_f, p.x);
+    const FieldElement y(*_f, p.y);
+    const _ExtendedPoint point = { x, y, _one, x * y };
+
+    _ExtendedPoint result = { FieldElement::zero(*_f), _one, _one, FieldElement::zero(*_f) };
+    const auto bits = toBinary(k);
+    for (int i = bits.size() - 1; i >= 0; --i) {
+        result = _doubleExtended(result);
+        if (bits[i] == 1)
+            result = _addExtended(result, point);
+    }
+
+    const FieldElement z_inverse = result.z.inverted();
+    return { (result.x * z_inverse).toBigNum(), (result.y * z_inverse).toBigNum() };
+}
+
+const MontgomeryCurve& EdwardsCurve::montgomery() const {
+    return _montgomery;
+}
+
+Point EdwardsCurve::toMontgomery(const Point& p) const {
+    if (p == neutral)
+        return EllipticCurve::neutral;
+    if (p.x == 0_bn)
+        return { 0_bn, 0_bn };
+
+    ///u = (1 + y)/(1 - y), v = u/x
+    const FieldElement y(*_f, p.y);
+    const auto inverses = invertedBatch({ _one - y, FieldElement(*_f, p.x) });
+    const FieldElement u = (_one + y) * inverses[0];
+    return { u.toBigNum(), (u * inverses[1]).toBigNum() };
+}
+
+Point EdwardsCurve::fromMontgomery(const Point& p) const {
+    if (p == EllipticCurve::neutral)
+        return neutral;
+    if (p.x == 0_bn && p.y == 0_bn)
+        return { 0_bn, _f->modulo() - 1_bn };
+
+    const FieldElement u(*_f, p.x);
+    const FieldElement v(*_f, p.y);
+    if (v.isZero() || (u + _one).isZero())
+        throw std::invalid_argument("Point lies at infinity of Edwards curve.");
+
+    ///x = u/v, y = (u - 1)/(u + 1)
+    const auto inverses = invertedBatch({ v, u + _one });
+    return { (u * inverses[0]).toBigNum(), ((u - _one) * inverses[1]).toBigNum() };
+}
+
+const MontgomeryCurve& curve25519() {
+    static const MontgomeryCurve curve(
+        std::make_shared<const Field>(BigNum("57896044618658097711785492504343953926634992332820282019728792003956564819949")),
+        486662_bn, 1_bn);
+    return curve;
+}
+
+std::vector<uint8_t> x25519(const std::vector<uint8_t>& scalar, const std::vector<uint8_t>& u) {
+    if (scalar.size() != 32)
+        throw std::invalid_argument("X25519 scalar must take 32 bytes.");
+
+    ///clamping: multiple of cofactor 8 with bit 254 set, so the ladder always runs 255 steps
+    std::vector<uint8_t> clamped(scalar.rbegin(), scalar.rend());
+    clamped[31] &= 248;
+    clamped[0] &= 127;
+    clamped[0] |= 64;
+
+    const MontgomeryCurve& curve = curve25519();
+    return curve.encodeU(curve.ladder(curve.decodeU(u), fromBytes(clamped)));
+}
+
+} // namespace lab
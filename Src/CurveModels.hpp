@@ -0,0 +1,170 @@
+#pragma once
+
+#include "BigNum.hpp"
+#include "EllipticCurves.hpp"
+#include "Field.hpp"
+#include "FieldElement.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace lab {
+
+/**
+ * @brief Montgomery curve B*v^2 = u^3 + A*u^2 + u over prime field, points are (u, v) with
+ *        EllipticCurve::neutral as the neutral one. Birationally equivalent to short Weierstrass
+ *        curve by (u, v) -> (u/B + A/(3B), v/B), group operations besides ladder go through it
+ */
+class MontgomeryCurve {
+public:
+    /**
+     * @throws std::invalid_argument if B = 0, A = 2 or A = -2 (singular curve)
+     */
+    MontgomeryCurve(std::shared_ptr<const Field> f, const BigNum& a, const BigNum& b);
+
+    const std::shared_ptr<const Field>& getField() const;
+
+    const BigNum& getA() const;
+
+    const BigNum& getB() const;
+
+    bool contains(const Point& p) const;
+
+    Point addPoints(const Point& first, const Point& second) const;
+
+    Point powerPoint(const Point& p, const BigNum& k) const;
+
+    /**
+     * @brief x-only Montgomery ladder: one differential addition and one doubling in (X : Z)
+     *        for each of max(bits of k, bits of modulo) bits, B is never used
+     * @return u of k * (u, v) for any point with this u, 0 if it is the neutral point
+     */
+    BigNum ladder(const BigNum& u, const BigNum& k) const;
+
+    /**
+     * @brief u as little-endian bytes of modulo length (RFC 7748), the whole x-only public key
+     */
+    std::vector<uint8_t> encodeU(const BigNum& u) const;
+
+    /**
+     * @brief Little-endian u with unused bits of the last byte masked, reduced modulo field modulo (RFC 7748)
+     * @throws std::invalid_argument if length differs from bytes of modulo
+     */
+    BigNum decodeU(const std::vector<uint8_t>& bytes) const;
+
+    /**
+     * @return Short Weierstrass curve y^2 = x^3 + a*x + b with a = (3 - A^2)/(3B^2), b = (2A^3 - 9A)/(27B^3)
+     */
+    const EllipticCurve& weierstrass() const;
+
+    Point toWeierstrass(const Point& p) const;
+
+    Point fromWeierstrass(const Point& p) const;
+
+private:
+    std::shared_ptr<const Field> _f;
+    BigNum _a;
+    BigNum _b;
+    FieldElement _a_element;
+    FieldElement _b_element;
+    /// (A - 2) / 4 of ladder doubling
+    FieldElement _a24;
+    /// A / 3 and 1 / B of the maps
+    FieldElement _a_third;
+    FieldElement _b_inverse;
+    EllipticCurve _weierstrass;
+};
+
+/**
+ * @brief Twisted Edwards curve a*x^2 + y^2 = 1 + d*x^2*y^2 over prime field. Neutral point is (0, 1),
+ *        addition is unified (doubling is not a special case) and complete if a is a square and d is not.
+ *        Birationally equivalent to Montgomery curve with A = 2(a + d)/(a - d), B = 4/(a - d)
+ *        by (x, y) -> ((1 + y)/(1 - y), (1 + y)/((1 - y)x))
+ */
+class EdwardsCurve {
+public:
+    /**
+     * @throws std::invalid_argument if a = 0, d = 0 or a = d (singular curve)
+     */
+    EdwardsCurve(std::shared_ptr<const Field> f, const BigNum& a, const BigNum& d);
+
+    static inline const Point neutral = { 0_bn, 1_bn };
+
+    const std::shared_ptr<const Field>& getField() const;
+
+    const BigNum& getA() const;
+
+    const BigNum& getD() const;
+
+    /**
+     * @return True if a is a square and d is not, then addPoints has no exceptional cases
+     */
+    bool isComplete() const;
+
+    bool contains(const Point& p) const;
+
+    Point invertedPoint(const Point& p) const;
+
+    /**
+     * @brief x3 = (x1*y2 + y1*x2)/(1 + d*x1*x2*y1*y2), y3 = (y1*y2 - a*x1*x2)/(1 - d*x1*x2*y1*y2)
+     * @throws std::invalid_argument if a denominator is zero, possible only on incomplete curve
+     */
+    Point addPoints(const Point& first, const Point& second) const;
+
+    /**
+     * @brief Double-and-add in extended coordinates (X : Y : Z : T), x = X/Z, y = Y/Z, T = XY/Z,
+     *        with unified addition of Hisil–Wong–Carter–Dawson, one inversion at the end
+     */
+    Point powerPoint(const Point& p, const BigNum& k) const;
+
+    const MontgomeryCurve& montgomery() const;
+
+    /**
+     * @brief (0, 1) goes to neutral and (0, -1) to (0, 0)
+     */
+    Point toMontgomery(const Point& p) const;
+
+    /**
+     * @throws std::invalid_argument for points with v = 0 or u = -1 besides (0, 0),
+     *         they lie at infinity of Edwards curve
+     */
+    Point fromMontgomery(const Point& p) const;
+
+private:
+    /**
+     * @brief Point in extended coordinates
+     */
+    struct _ExtendedPoint {
+        FieldElement x;
+        FieldElement y;
+        FieldElement z;
+        FieldElement t;
+    };
+
+    _ExtendedPoint _addExtended(const _ExtendedPoint& first, const _ExtendedPoint& second) const;
+
+    _ExtendedPoint _doubleExtended(const _ExtendedPoint& p) const;
+
+    std::shared_ptr<const Field> _f;
+    BigNum _a;
+    BigNum _d;
+    FieldElement _a_element;
+    FieldElement _d_element;
+    FieldElement _one;
+    MontgomeryCurve _montgomery;
+};
+
+/**
+ * @brief X25519 function of RFC 7748: ladder on Curve25519 v^2 = u^3 + 486662*u^2 + u with clamped scalar
+ * @param scalar and u are 32 little-endian bytes each
+ * @return u of the product, 32 little-endian bytes
+ */
+std::vector<uint8_t> x25519(const std::vector<uint8_t>& scalar, const std::vector<uint8_t>& u);
+
+/**
+ * @brief Curve25519 in Montgomery form, shared by all callers
+ */
+const MontgomeryCurve& curve25519();
+
+} // namespace lab
@@ -1,8 +1,338 @@
 #include <EllipticCurves.hpp>
+#include <Polynomial.hpp>
+
+#include <unordered_map>
 
 namespace lab {
 
-EllipticCurve::EllipticCurve(Field* f, const BigNum& a, const BigNum& b): _f(f),_a(a),_b(b){}
+namespace {
+/**
+ * @brief Width of NAF window by scalar length: wider windows pay off only
+ *        when the table of 2^(w - 2) odd multiples is used often enough
+ */
+int nafWidth(int bits) {
+    if (bits < 16)
+        return 2;
+    if (bits < 80)
+        return 3;
+    if (bits < 240)
+        return 4;
+    return 5;
+}
+
+/**
+ * @brief Width-w non-adjacent form of scalar: digits are zero or odd with |d| < 2^(w - 1),
+ *        any w consecutive digits contain at most one non zero
+ * @return Digits, the least significant first
+ */
+std::vector<int> wNaf(const BigNum& scalar, int width) {
+    auto bits = toBinary(scalar);
+    bits.resize(bits.size() + width + 1, 0);
+
+    std::vector<int> digits;
+    for (int i = 0; i < bits.size(); ) {
+        if (bits[i] == 0) {
+            digits.push_back(0);
+            ++i;
+            continue;
+        }
+
+        int value = 0;
+        for (int bit = i + width - 1; bit >= i; --bit) {
+            value = value * 2 + (bit < bits.size() ? bits[bit] : 0);
+            if (bit < bits.size())
+                bits[bit] = 0;
+        }
+
+        /// take value - 2^w and carry 2^w into the next window
+        if (value >= (1 << (width - 1))) {
+            value -= 1 << width;
+            for (int bit = i + width; bit < bits.size(); ++bit) {
+                bits[bit] ^= 1;
+                if (bits[bit] == 1)
+                    break;
+            }
+        }
+
+        digits.push_back(value);
+        for (int j = 1; j < width; ++j)
+            digits.push_back(0);
+        i += width;
+    }
+
+    while (!digits.empty() && digits.back() == 0)
+        digits.pop_back();
+    return digits;
+}
+
+/**
+ * @brief Signed number as absolute value and sign (true for negative), BigNum holds non negative numbers only
+ */
+using Signed = std::pair<BigNum, bool>;
+
+Signed normalized(const Signed& num) {
+    return { num.first, num.second && num.first != 0_bn };
+}
+
+Signed signedAdd(const Signed& left, const Signed& right) {
+    if (left.second == right.second)
+        return { left.first + right.first, left.second };
+    if (left.first >= right.first)
+        return normalized({ left.first - right.first, left.second });
+    return normalized({ right.first - left.first, right.second });
+}
+
+Signed signedSubtract(const Signed& left, const Signed& right) {
+    return signedAdd(left, normalized({ right.first, !right.second }));
+}
+
+Signed signedMultiply(const Signed& left, const Signed& right) {
+    return normalized({ left.first * right.first, left.second != right.second });
+}
+
+/**
+ * @brief Thrown by TorsionRing when an element turns out to be a non zero divisor of zero,
+ *        factor is the common divisor with ring modulus
+ */
+struct ZeroDivisor {
+    Polynomial factor;
+};
+
+/**
+ * @brief Point (x, y * y_factor) of l-torsion with coordinates in TorsionRing
+ */
+struct TorsionPoint {
+    Polynomial x;
+    Polynomial y_factor;
+    bool is_neutral = false;
+
+    friend bool operator==(const TorsionPoint& left, const TorsionPoint& right) {
+        if (left.is_neutral || right.is_neutral)
+            return left.is_neutral == right.is_neutral;
+        return left.x == right.x && left.y_factor == right.y_factor;
+    }
+};
+
+/**
+ * @brief Ring F_p[x, y] / (modulus(x), y^2 - rhs(x)) used by Schoof's algorithm, modulus is
+ *        division polynomial or its factor, so generic point (x, y) is a point of l-torsion.
+ *        Every element is kept as y^e * c(x) with c reduced modulo modulus
+ */
+class TorsionRing {
+public:
+    TorsionRing(const Polynomial& modulus, const Polynomial& rhs, const BigNum& a)
+        : _modulus(modulus), _rhs(_modulus.reduce(rhs)), _a(a) {}
+
+    const PolynomialModulus& modulus() const {
+        return _modulus;
+    }
+
+    /**
+     * @throws ZeroDivisor if element is not invertible
+     */
+    Polynomial invert(const Polynomial& poly) const {
+        const auto [divisor, inverse] = extendedGcd(poly, _modulus.modulo());
+        if (divisor.degree() != 0)
+            throw ZeroDivisor{ divisor };
+        return inverse;
+    }
+
+    TorsionPoint neutral() const {
+        const Polynomial zero(_rhs.getField());
+        return { zero, zero, true };
+    }
+
+    TorsionPoint addPoints(const TorsionPoint& first, const TorsionPoint& second) const {
+        if (first.is_neutral)
+            return second;
+        if (second.is_neutral)
+            return first;
+
+        const auto& field = _rhs.getField();
+        Polynomial slope(field);
+        if (first.x == second.x) {
+            if (first.y_factor != second.y_factor) {
+                if ((first.y_factor + second.y_factor).isZero())
+                    return neutral();
+                ///points are equal over some roots of modulus and opposite over the others
+                throw ZeroDivisor{ gcd(_modulus.modulo(), first.y_factor - second.y_factor) };
+            }
+            if (first.y_factor.isZero())
+                return neutral();
+
+            ///(3*x^2 + A) / (2 * y * y_factor) = y * (3*x^2 + A) / (2 * rhs * y_factor)
+            const Polynomial numerator = _modulus.multiply(first.x, first.x) * 3_bn + Polynomial(field, { _a });
+            slope = _modulus.multiply(numerator, invert(_modulus.multiply(_rhs * 2_bn, first.y_factor)));
+        } else {
+            slope = _modulus.multiply(second.y_factor - first.y_factor, invert(second.x - first.x));
+        }
+
+        ///slope is y * slope(x), so its square is rhs * slope(x)^2
+        const Polynomial x = _modulus.multiply(_rhs, _modulus.multiply(slope, slope)) - first.x - second.x;
+        const Polynomial y_factor = _modulus.multiply(slope, first.x - x) - first.y_factor;
+        return { x, y_factor };
+    }
+
+    TorsionPoint powerPoint(const TorsionPoint& point, int k) const {
+        TorsionPoint result = neutral();
+        for (int bit = 30; bit >= 0; --bit) {
+            result = addPoints(result, result);
+            if ((k >> bit) & 1)
+                result = addPoints(result, point);
+        }
+        return result;
+    }
+
+private:
+    PolynomialModulus _modulus;
+    Polynomial _rhs;
+    BigNum _a;
+};
+
+/**
+ * @brief Trace of Frobenius modulo odd prime l: the tau with pi^2(P) + (p mod l) * P = tau * pi(P)
+ *        for l-torsion point P. A zero divisor met on the way gives a factor of the modulus,
+ *        the search is restarted in the smaller ring
+ */
+int frobeniusTrace(int l, Polynomial modulus, const Polynomial& rhs, const BigNum& a) {
+    const auto& field = rhs.getField();
+    const BigNum& mod = field->modulo();
+    while (true) {
+        try {
+            const TorsionRing ring(modulus, rhs, a);
+
+            ///pi(x, y) = (x^p, y^p) = (x^p, y * rhs^((p - 1) / 2)), pi^2 applies it twice
+            const TorsionPoint point = { ring.modulus().reduce(Polynomial::monomial(field, 1)),
+                                         Polynomial(field, { 1_bn }) };
+            const Polynomial y_factor = ring.modulus().pow(rhs, (mod - 1_bn) / 2_bn);
+            const TorsionPoint frobenius = { ring.modulus().pow(point.x, mod), y_factor };
+            const TorsionPoint frobenius_squared = { ring.modulus().pow(frobenius.x, mod),
+                                                     ring.modulus().multiply(ring.modulus().pow(y_factor, mod), y_factor) };
+
+            const int residue = std::stoi(to_string(mod % BigNum(std::to_string(l))));
+            const TorsionPoint left = ring.addPoints(frobenius_squared, ring.powerPoint(point, residue));
+            if (left.is_neutral)
+                return 0;
+
+            TorsionPoint right = frobenius;
+            for (int tau = 1; tau < l; ++tau) {
+                if (right == left)
+                    return tau;
+                right = ring.addPoints(right, frobenius);
+            }
+            throw std::logic_error("Frobenius trace not found, curve is singular or modulo is not prime.");
+        } catch (const ZeroDivisor& zero_divisor) {
+            modulus = zero_divisor.factor;
+        }
+    }
+}
+
+/**
+ * @brief Non trivial factor of odd composite num by Pollard's rho with Brent's cycle detection,
+ *        O(f^(1/2)) steps for the least prime factor f, differences are multiplied together
+ *        and gcd is taken once per RHO_GCD_BATCH steps
+ */
+BigNum rhoFactor(const BigNum& num) {
+    constexpr std::size_t RHO_GCD_BATCH = 64;
+    const auto distance = [](const BigNum& x, const BigNum& y) {
+        return x > y ? x - y : y - x;
+    };
+
+    for (BigNum c = 1_bn; ; c = c + 1_bn) {
+        const auto next = [&](const BigNum& x) {
+            return add(multiply(x, x, num), c, num);
+        };
+
+        BigNum x = 2_bn;
+        BigNum y = 2_bn;
+        BigNum saved = 2_bn;
+        BigNum product = 1_bn;
+        BigNum divisor = 1_bn;
+        for (std::size_t length = 1; divisor == 1_bn; length *= 2) {
+            x = y;
+            for (std::size_t i = 0; i < length && divisor == 1_bn; i += RHO_GCD_BATCH) {
+                saved = y;
+                for (std::size_t j = i; j < std::min(length, i + RHO_GCD_BATCH); ++j) {
+                    y = next(y);
+                    product = multiply(product, distance(x, y), num);
+                }
+                divisor = gcd(product, num);
+            }
+        }
+
+        ///the batch took in every prime factor at once, replay it one step at a time
+        if (divisor == num) {
+            do {
+                saved = next(saved);
+                divisor = gcd(distance(x, saved), num);
+            } while (divisor == 1_bn);
+        }
+        if (divisor != num)
+            return divisor;
+    }
+}
+
+/**
+ * @brief Prime factorization of num > 0: trial division up to bound, Pollard's rho for the rest,
+ *        whose prime factors are all above bound
+ * @return Primes with exponents in no particular order
+ */
+std::vector<std::pair<BigNum, int>> factorized(BigNum num, const BigNum& bound) {
+    std::vector<std::pair<BigNum, int>> factors;
+    const auto add_factor = [&factors](const BigNum& prime) {
+        for (auto& [known, exponent] : factors) {
+            if (known == prime) {
+                ++exponent;
+                return;
+            }
+        }
+        factors.emplace_back(prime, 1);
+    };
+
+    for (BigNum d = 2_bn; d <= bound && d * d <= num; d = d + (d == 2_bn ? 1_bn : 2_bn)) {
+        while (num % d == 0_bn) {
+            num = num / d;
+            add_factor(d);
+        }
+    }
+
+    std::vector<BigNum> rest;
+    if (num != 1_bn)
+        rest.push_back(num);
+    while (!rest.empty()) {
+        const BigNum current = rest.back();
+        rest.pop_back();
+        if (current <= bound * bound || Field(current).isPrime()) {
+            add_factor(current);
+            continue;
+        }
+        const BigNum factor = rhoFactor(current);
+        rest.push_back(factor);
+        rest.push_back(current / factor);
+    }
+    return factors;
+}
+
+/**
+ * @brief Field modulo below this bit length has points counted by the sum of Legendre symbols
+ */
+constexpr int SCHOOF_MIN_BITS = 16;
+
+/**
+ * @brief Number of points from which multiScalarMul switches from Straus to Pippenger
+ */
+constexpr int MIN_FOR_PIPPENGER = 16;
+} // <anonymous> namespace
+
+EllipticCurve::EllipticCurve(std::shared_ptr<const Field> f, const BigNum& a, const BigNum& b): _f(std::move(f)),_a(a),_b(b){
+    if (_a % _f->modulo() == 0_bn)
+        _shape = Shape::AZero;
+    else if (add(_a, 3_bn, _f->modulo()) == 0_bn)
+        _shape = Shape::AMinusThree;
+    _a_element = FieldElement(*_f, _a);
+    _b_element = FieldElement(*_f, _b);
+    _one = FieldElement::one(*_f);
+}
 
 bool operator==(const EllipticCurve& left, const EllipticCurve& right) {
     return (*left._f == *right._f) && (left._a == right._a) && (left._b == right._b);
@@ -16,17 +346,30 @@ bool EllipticCurve::contains(const Point& p) const {
     if (p == neutral)
         return true;
 
-    /// y^2 == x^3 + A*x + B
-    if ((p.y * p.y) % _f->modulo == ((p.x * p.x * p.x + _a * p.x + _b) % _f->modulo))
-       return true;
-    else
-       return false;
- }
+    /// y^2 == (x^2 + A)*x + B
+    const FieldElement x(*_f, p.x);
+    return FieldElement(*_f, p.y).squared() == (x.squared() + _a_element) * x + _b_element;
+}
+
+bool EllipticCurve::isValidPublicKey(const Point& p, const std::optional<BigNum>& subgroup_order) const {
+    const BigNum& mod = _f->modulo();
+    if (p == neutral || p.x >= mod || p.y >= mod || !contains(p))
+        return false;
+
+    ///single point goes past GLV, which would reduce the scalar modulo order to zero
+    return !subgroup_order || multiScalarMul({ p }, { *subgroup_order }) == neutral;
+}
 
 Point EllipticCurve::invertedPoint(const Point& p) const {
     if (p == neutral)
         return neutral;
-    return { p.x, subtract(_f->modulo, p.y,_f->modulo) };
+    return { p.x, subtract(_f->modulo(), p.y,_f->modulo()) };
+}
+
+JacobianPoint EllipticCurve::invertedPoint(const JacobianPoint& p) const {
+    if (p.z.isZero())
+        return p;
+    return { p.x, -p.y, p.z };
 }
 
 Point EllipticCurve::addPoints(const Point& first, const Point& second) const {
@@ -38,185 +381,885 @@ Point EllipticCurve::addPoints(const Point& first, const Point& second) const {
     {
         return neutral;
     } else {
-        BigNum tmp1;
-        BigNum tmp2;
-        BigNum m;
+        const FieldElement x1(*_f, first.x);
+        const FieldElement y1(*_f, first.y);
+        const FieldElement x2(*_f, second.x);
+        FieldElement tmp1;
+        FieldElement tmp2;
         if (first.x != second.x) {
             ///y2-y1
-            tmp1 = subtract(second.y, first.y, _f->modulo);
+            tmp1 = FieldElement(*_f, second.y) - y1;
 
             ///x2-x1
-            tmp2 = subtract(second.x, first.x, _f->modulo);
+            tmp2 = x2 - x1;
         } else {
-            ///x1^2
-            tmp1 = powMontgomery(first.x, 2_bn, _f->modulo);
-            
-            ///3*x1^2
-            tmp1 = multiply(3_bn, tmp1, _f->modulo);
-            
             ///3*x1^2 + A
-            tmp1 = add(tmp1, _a, _f->modulo);
-            
+            tmp1 = _tangentNumerator(x1, _one);
+
             ///2*y1
-            tmp2 = multiply(2_bn, first.y, _f->modulo);
+            tmp2 = y1.doubled();
         }
-        
-        ///(y2 - y1)/(x2 - x1) or (3*x1^2 + A)/(2*y1)
-        m = multiply(tmp1, inverted(tmp2, _f->modulo, BigNum::InversionPolicy::Fermat), _f->modulo);
 
-        ///m^2
-        tmp1 = multiply(m, m, _f->modulo); 
+        ///(y2 - y1)/(x2 - x1) or (3*x1^2 + A)/(2*y1)
+        const FieldElement m = tmp1 * tmp2.inverted();
 
-        ///x1 + x2
-        tmp2 = add(first.x, second.x, _f->modulo); 
-		
         ///x3 = m^2 - x1 - x2
-        tmp1 = subtract(tmp1, tmp2, _f->modulo); 
+        const FieldElement x3 = m.squared() - x1 - x2;
 
-        ///x1 - x3
-        tmp2 = subtract(first.x, tmp1, _f->modulo); 			
-
-        ///m*(x1 - x3)
-        tmp2 = multiply(m, tmp2, _f->modulo); 
-        
         ///y3 = m*(x1 - x3) - y1
-        tmp2 = subtract(tmp2, first.y, _f->modulo); 
+        const FieldElement y3 = m * (x1 - x3) - y1;
 
         ///{x3,y3} - answer
-        return{ tmp1,tmp2 };
+        return{ x3.toBigNum(), y3.toBigNum() };
+    }
+}
+
+void EllipticCurve::addPointsBatch(const std::vector<Point>& first, const std::vector<Point>& second,
+                                   std::vector<Point>& out) const {
+    if (first.size() != second.size())
+        throw std::invalid_argument("Every point needs a pair.");
+
+    ///lanes which need slope m = numerator / denominator, others are answered right away
+    std::vector<int> lanes;
+    std::vector<FieldElement> numerators;
+    std::vector<FieldElement> denominators;
+    out.clear();
+    out.reserve(first.size());
+    for (int i = 0; i < first.size(); ++i) {
+        const Point& p = first[i];
+        const Point& q = second[i];
+        if (p == neutral || q == neutral) {
+            out.push_back(p == neutral ? q : p);
+        } else if ((p.x == q.x && p.y != q.y) || (p == q && p.y == 0_bn)) {
+            out.push_back(neutral);
+        } else {
+            out.push_back(neutral);
+            lanes.push_back(i);
+            if (p == q) {
+                ///(3*x1^2 + A)/(2*y1)
+                numerators.push_back(_tangentNumerator(FieldElement(*_f, p.x), _one));
+                denominators.push_back(FieldElement(*_f, p.y).doubled());
+            } else {
+                ///(y2 - y1)/(x2 - x1)
+                numerators.push_back(FieldElement(*_f, q.y) - FieldElement(*_f, p.y));
+                denominators.push_back(FieldElement(*_f, q.x) - FieldElement(*_f, p.x));
+            }
+        }
+    }
+
+    const auto inverses = invertedBatch(denominators);
+    for (int j = 0; j < lanes.size(); ++j) {
+        const FieldElement x1(*_f, first[lanes[j]].x);
+        const FieldElement y1(*_f, first[lanes[j]].y);
+        const FieldElement x2(*_f, second[lanes[j]].x);
+        const FieldElement m = numerators[j] * inverses[j];
+
+        ///x3 = m^2 - x1 - x2
+        const FieldElement x3 = m.squared() - x1 - x2;
+
+        ///y3 = m*(x1 - x3) - y1
+        const FieldElement y3 = m * (x1 - x3) - y1;
+
+        out[lanes[j]] = { x3.toBigNum(), y3.toBigNum() };
+    }
+}
+
+JacobianPoint EllipticCurve::toJacobian(const Point& p) const {
+    if (p == neutral)
+        return { _one, _one, FieldElement::zero(*_f) };
+    return { FieldElement(*_f, p.x), FieldElement(*_f, p.y), _one };
+}
+
+Point EllipticCurve::toAffine(const JacobianPoint& p) const {
+    if (p.z.isZero())
+        return neutral;
+
+    const FieldElement z_inv = p.z.inverted();
+    const FieldElement z_inv2 = z_inv.squared();
+
+    ///{x/z^2, y/z^3}
+    return { (p.x * z_inv2).toBigNum(), (p.y * z_inv2 * z_inv).toBigNum() };
+}
+
+std::vector<Point> EllipticCurve::normalizeBatch(const std::vector<JacobianPoint>& points) const {
+    ///neutral points have z = 0 and don't take part in inversion
+    std::vector<FieldElement> zs;
+    for (const auto& p : points) {
+        if (!p.z.isZero())
+            zs.push_back(p.z);
+    }
+    const auto z_inverses = invertedBatch(zs);
+
+    std::vector<Point> result;
+    result.reserve(points.size());
+    auto z_inv = z_inverses.begin();
+    for (const auto& p : points) {
+        if (p.z.isZero()) {
+            result.push_back(neutral);
+            continue;
+        }
+        const FieldElement z_inv2 = z_inv->squared();
+
+        ///{x/z^2, y/z^3}
+        result.push_back({ (p.x * z_inv2).toBigNum(), (p.y * z_inv2 * *z_inv).toBigNum() });
+        ++z_inv;
+    }
+    return result;
+}
+
+JacobianPoint EllipticCurve::doublePoint(const JacobianPoint& p) const {
+    if (p.z.isZero() || p.y.isZero())
+        return toJacobian(neutral);
+
+    ///y^2, y^4
+    const FieldElement yy = p.y.squared();
+    const FieldElement yyyy = yy.squared();
+
+    ///s = 4*x*y^2
+    const FieldElement s = (p.x * yy).lazy().doubled().doubled().reduced();
+
+    ///m = 3*x^2 + A*z^4
+    const FieldElement m = _tangentNumerator(p.x, p.z);
+
+    ///x3 = m^2 - 2*s
+    const FieldElement x3 = m.squared() - s.doubled();
+
+    ///y3 = m*(s - x3) - 8*y^4
+    const FieldElement y3 = m * (s - x3) - yyyy.lazy().doubled().doubled().doubled().reduced();
+
+    ///z3 = 2*y*z
+    const FieldElement z3 = (p.y * p.z).doubled();
+
+    return { x3, y3, z3 };
+}
+
+JacobianPoint EllipticCurve::addPoints(const JacobianPoint& first, const JacobianPoint& second) const {
+    if (first.z.isZero())
+        return second;
+    if (second.z.isZero())
+        return first;
+
+    ///normalized points (z = 1) take the cheaper mixed addition
+    if (second.z == _one)
+        return _addMixed(first, second.x, second.y);
+    if (first.z == _one)
+        return _addMixed(second, first.x, first.y);
+
+    const FieldElement z1z1 = first.z.squared();
+    const FieldElement z2z2 = second.z.squared();
+
+    ///u1 = x1*z2^2, u2 = x2*z1^2, s1 = y1*z2^3, s2 = y2*z1^3
+    const FieldElement u1 = first.x * z2z2;
+    const FieldElement u2 = second.x * z1z1;
+    const FieldElement s1 = first.y * (second.z * z2z2);
+    const FieldElement s2 = second.y * (first.z * z1z1);
+
+    if (u1 == u2)
+        return s1 == s2 ? doublePoint(first) : toJacobian(neutral);
+
+    ///h = u2 - u1, r = s2 - s1
+    const FieldElement h = u2 - u1;
+    const FieldElement r = s2 - s1;
+    const FieldElement hh = h.squared();
+    const FieldElement hhh = hh * h;
+    const FieldElement v = u1 * hh;
+
+    ///x3 = r^2 - (h^3 + 2*u1*h^2)
+    const FieldElement x3 = r.squared() - (hhh.lazy() + v + v).reduced();
+
+    ///y3 = r*(u1*h^2 - x3) - s1*h^3
+    const FieldElement y3 = r * (v - x3) - s1 * hhh;
+
+    ///z3 = h*z1*z2
+    const FieldElement z3 = h * (first.z * second.z);
+
+    return { x3, y3, z3 };
+}
+
+JacobianPoint EllipticCurve::addPoints(const JacobianPoint& first, const Point& second) const {
+    if (second == neutral)
+        return first;
+    if (first.z.isZero())
+        return toJacobian(second);
+    return _addMixed(first, FieldElement(*_f, second.x), FieldElement(*_f, second.y));
+}
+
+JacobianPoint EllipticCurve::_addMixed(const JacobianPoint& first, const FieldElement& x2, const FieldElement& y2) const {
+    const FieldElement z1z1 = first.z.squared();
+
+    ///second point has z2 = 1: u1 = x1, s1 = y1, u2 = x2*z1^2, s2 = y2*z1^3
+    const FieldElement u2 = x2 * z1z1;
+    const FieldElement s2 = y2 * (first.z * z1z1);
+
+    if (first.x == u2)
+        return first.y == s2 ? doublePoint(first) : toJacobian(neutral);
+
+    ///h = u2 - x1, r = s2 - y1
+    const FieldElement h = u2 - first.x;
+    const FieldElement r = s2 - first.y;
+    const FieldElement hh = h.squared();
+    const FieldElement hhh = hh * h;
+    const FieldElement v = first.x * hh;
+
+    ///x3 = r^2 - (h^3 + 2*x1*h^2)
+    const FieldElement x3 = r.squared() - (hhh.lazy() + v + v).reduced();
+
+    ///y3 = r*(x1*h^2 - x3) - y1*h^3
+    const FieldElement y3 = r * (v - x3) - first.y * hhh;
+
+    ///z3 = h*z1
+    const FieldElement z3 = h * first.z;
+
+    return { x3, y3, z3 };
+}
+
+FieldElement EllipticCurve::_tangentNumerator(const FieldElement& x, const FieldElement& z) const {
+    switch (_shape) {
+    case Shape::AZero: {
+        ///3*x^2
+        const FieldElement xx = x.squared();
+        return (xx.lazy() + xx + xx).reduced();
+    }
+    case Shape::AMinusThree: {
+        ///3*x^2 - 3*z^4 = 3*(x - z^2)*(x + z^2)
+        const FieldElement zz = z == _one ? z : z.squared();
+        const FieldElement t = (x - zz) * (x + zz);
+        return (t.lazy() + t + t).reduced();
+    }
+    default: {
+        ///3*x^2 + A*z^4
+        const FieldElement xx = x.squared();
+        return (xx.lazy() + xx + xx + _a_element * z.squared().squared()).reduced();
+    }
     }
 }
 
 /**
- * @brief Following function provides taking the point to the power of a
+ * @brief Following function provides taking the point to the power of a:
+ *        left-to-right over width-w NAF digits with table p, 3p, ..., (2^(w - 1) - 1)p,
+ *        negative digits add the inverted table entry
  */
+Point EllipticCurve::powerPoint(const Point& point, const BigNum& a) const {
+    if (point == neutral)
+        return neutral;
+
+    ///a * p = k1 * p + k2 * (beta * x, y) with half-length k1, k2 sharing doublings
+    if (_glv) {
+        const auto [k1, k2] = _glvDecompose(a % _glv->order);
+        const Point endomorphism = { multiply(_glv->beta, point.x, _f->modulo()), point.y };
+        return multiScalarMul({ k1.second ? invertedPoint(point) : point,
+                                k2.second ? invertedPoint(endomorphism) : endomorphism },
+                              { k1.first, k2.first });
+    }
+
+    const int width = nafWidth(bitLength(a));
+    const auto digits = wNaf(a, width);
+
+    std::vector<JacobianPoint> odd_multiples = { toJacobian(point) };
+    const JacobianPoint doubled = doublePoint(odd_multiples[0]);
+    for (int i = 1; i < (1 << (width - 2)); ++i)
+        odd_multiples.push_back(addPoints(odd_multiples.back(), doubled));
+
+    JacobianPoint result = toJacobian(neutral);
+    for (int i = digits.size() - 1; i >= 0; --i) {
+        result = doublePoint(result);
+        if (digits[i] > 0)
+            result = addPoints(result, odd_multiples[digits[i] / 2]);
+        else if (digits[i] < 0)
+            result = addPoints(result, invertedPoint(odd_multiples[-digits[i] / 2]));
+    }
+    return toAffine(result);
+}
+
+template<typename PointType>
+void EllipticCurve::_conditionalSwap(bool bit, PointType& first, PointType& second) {
+    if (bit)
+        std::swap(first, second);
+}
+
+Point EllipticCurve::powerPointLadder(const Point& point, const BigNum& a) const {
+    if (point == neutral)
+        return neutral;
+
+    /// fixed number of steps: group order is below 2 * modulo, so reduced scalars fit bits of modulo + 1
+    auto bits = toBinary(a);
+    bits.resize(std::max<int>(bits.size(), _f->bitLength() + 1), 0);
+
+    /// point of order 2
+    if (point.y == 0_bn)
+        return bits[0] == 1 ? point : neutral;
+
+    if (point.x == 0_bn)
+        return _powerPointLadderJacobian(point, bits);
 
-    Point EllipticCurve::powerPoint(const Point& point, const BigNum& a) const {
-        if (a == 0_bn){
-            return neutral;
+    const FieldElement px(*_f, point.x);
+    const FieldElement b4 = _b_element.doubled().doubled();
+    const FieldElement b8 = b4.doubled();
+
+    /// r0 = (x0 : z0) = k * p, r1 = (x1 : z1) = (k + 1) * p, starts from k = 0
+    std::pair<FieldElement, FieldElement> r0 = { _one, FieldElement::zero(*_f) };
+    std::pair<FieldElement, FieldElement> r1 = { px, _one };
+
+    for (int i = bits.size() - 1; i >= 0; --i) {
+        _conditionalSwap(bits[i] == 1, r0, r1);
+        const auto& [x0, z0] = r0;
+        const auto& [x1, z1] = r1;
+
+        ///differential addition with difference p:
+        ///x = (x0*x1 - A*z0*z1)^2 - 4B*z0*z1*(x0*z1 + x1*z0), z = x_p*(x0*z1 - x1*z0)^2
+        const FieldElement z0z1 = z0 * z1;
+        const FieldElement x0z1 = x0 * z1;
+        const FieldElement x1z0 = x1 * z0;
+        FieldElement t = x0 * x1 - _a_element * z0z1;
+        FieldElement sum_x = t.squared() - b4 * (z0z1 * (x0z1 + x1z0));
+        t = x0z1 - x1z0;
+        FieldElement sum_z = px * t.squared();
+
+        ///doubling: x = (x0^2 - A*z0^2)^2 - 8B*x0*z0^3, z = 4*z0*(x0^3 + A*x0*z0^2 + B*z0^3)
+        const FieldElement xx = x0.squared();
+        const FieldElement zz = z0.squared();
+        t = xx - _a_element * zz;
+        FieldElement double_x = t.squared() - b8 * (x0 * (z0 * zz));
+        t = x0 * (xx + _a_element * zz) + _b_element * (z0 * zz);
+        FieldElement double_z = (z0 * t).lazy().doubled().doubled().reduced();
+
+        r1 = { std::move(sum_x), std::move(sum_z) };
+        r0 = { std::move(double_x), std::move(double_z) };
+        _conditionalSwap(bits[i] == 1, r0, r1);
+    }
+
+    const auto& [x0, z0] = r0;
+    const auto& [x1, z1] = r1;
+    if (z0.isZero())
+        return neutral;
+    if (z1.isZero())
+        return invertedPoint(point);
+
+    ///one inversion of z0*z1*2y gives 1/z0, 1/z1 and 1/(2y)
+    const FieldElement two_y = FieldElement(*_f, point.y).doubled();
+    const FieldElement t = (z0 * z1 * two_y).inverted();
+    const FieldElement kx = x0 * (t * (z1 * two_y));
+    const FieldElement k1x = x1 * (t * (z0 * two_y));
+    const FieldElement two_y_inv = t * (z0 * z1);
+
+    ///y_k = (2B + (A + x*x_k)*(x + x_k) - x_(k+1)*(x - x_k)^2) / (2y)
+    const FieldElement diff = px - kx;
+    FieldElement ky = _b_element.doubled() + (_a_element + px * kx) * (px + kx);
+    ky = (ky - k1x * diff.squared()) * two_y_inv;
+
+    return { kx.toBigNum(), ky.toBigNum() };
+}
+
+Point EllipticCurve::_powerPointLadderJacobian(const Point& point, const std::vector<char>& bits) const {
+    JacobianPoint r0 = toJacobian(neutral);
+    JacobianPoint r1 = toJacobian(point);
+    for (int i = bits.size() - 1; i >= 0; --i) {
+        _conditionalSwap(bits[i] == 1, r0, r1);
+        r1 = addPoints(r0, r1);
+        r0 = doublePoint(r0);
+        _conditionalSwap(bits[i] == 1, r0, r1);
+    }
+    return toAffine(r0);
+}
+
+Point EllipticCurve::powerPointSecret(const Point& p, const BigNum& a) const {
+    if (_secret_scalar_mode == SecretScalarMode::Ladder)
+        return powerPointLadder(p, a);
+    return powerPoint(p, a);
+}
+
+Point EllipticCurve::multiScalarMul(const std::vector<Point>& points, const std::vector<BigNum>& scalars) const {
+    if (points.size() != scalars.size())
+        throw std::invalid_argument("Every point needs its scalar.");
+
+    JacobianPoint result = toJacobian(neutral);
+
+    if (points.size() == 2) {
+        ///Shamir's trick: one pass over bit pairs with table p, q, p + q
+        const auto first_bits = toBinary(scalars[0]);
+        const auto second_bits = toBinary(scalars[1]);
+        const JacobianPoint first_point = toJacobian(points[0]);
+        const JacobianPoint second_point = toJacobian(points[1]);
+        const JacobianPoint sum = addPoints(first_point, second_point);
+        for (int i = static_cast<int>(std::max(first_bits.size(), second_bits.size())) - 1; i >= 0; --i) {
+            result = doublePoint(result);
+            const bool first = i < first_bits.size() && first_bits[i] == 1;
+            const bool second = i < second_bits.size() && second_bits[i] == 1;
+            if (first && second)
+                result = addPoints(result, sum);
+            else if (first)
+                result = addPoints(result, first_point);
+            else if (second)
+                result = addPoints(result, second_point);
         }
-        if (a == 1_bn){
-            return point;
+    } else if (points.size() < MIN_FOR_PIPPENGER) {
+        ///Straus: NAF digits of all scalars interleaved, doublings are shared
+        std::vector<std::vector<int>> digits;
+        std::vector<std::vector<JacobianPoint>> odd_multiples;
+        int length = 0;
+        for (int i = 0; i < points.size(); ++i) {
+            const int width = nafWidth(bitLength(scalars[i]));
+            digits.push_back(wNaf(scalars[i], width));
+            length = std::max<int>(length, digits.back().size());
+
+            odd_multiples.push_back({ toJacobian(points[i]) });
+            const JacobianPoint doubled = doublePoint(odd_multiples.back()[0]);
+            for (int j = 1; j < (1 << (width - 2)); ++j)
+                odd_multiples.back().push_back(addPoints(odd_multiples.back().back(), doubled));
         }
-        std::pair<BigNum, BigNum> divMod = extract(a, 2_bn);
-        Point squared = powerPoint(point,divMod.first); // let squared be point^(a/2)
-        if(divMod.second == 0_bn) { // checking if a % 2 == 0
-            return addPoints(squared,squared);
 
-        } else {
-            return addPoints(addPoints(squared,squared),point);
+        for (int j = length - 1; j >= 0; --j) {
+            result = doublePoint(result);
+            for (int i = 0; i < points.size(); ++i) {
+                const int digit = j < digits[i].size() ? digits[i][j] : 0;
+                if (digit > 0)
+                    result = addPoints(result, odd_multiples[i][digit / 2]);
+                else if (digit < 0)
+                    result = addPoints(result, invertedPoint(odd_multiples[i][-digit / 2]));
+            }
+        }
+    } else {
+        ///Pippenger: points with the same window value share a bucket
+        const int window = std::max(2, static_cast<int>(std::log2(points.size())) - 1);
+        std::vector<std::vector<char>> bits;
+        std::vector<JacobianPoint> jacobian_points;
+        int length = 0;
+        for (int i = 0; i < points.size(); ++i) {
+            bits.push_back(toBinary(scalars[i]));
+            length = std::max<int>(length, bits.back().size());
+            jacobian_points.push_back(toJacobian(points[i]));
+        }
+
+        for (int from = (length - 1) / window * window; from >= 0; from -= window) {
+            for (int j = 0; j < window; ++j)
+                result = doublePoint(result);
+
+            std::vector<JacobianPoint> buckets((1 << window) - 1, toJacobian(neutral));
+            for (int i = 0; i < points.size(); ++i) {
+                int value = 0;
+                for (int bit = std::min<int>(bits[i].size(), from + window) - 1; bit >= from; --bit)
+                    value = value * 2 + bits[i][bit];
+                if (value != 0)
+                    buckets[value - 1] = addPoints(buckets[value - 1], jacobian_points[i]);
+            }
+
+            ///sum of d * bucket[d] as running sums from the biggest d
+            JacobianPoint running = toJacobian(neutral);
+            JacobianPoint window_sum = toJacobian(neutral);
+            for (int d = buckets.size() - 1; d >= 0; --d) {
+                running = addPoints(running, buckets[d]);
+                window_sum = addPoints(window_sum, running);
+            }
+            result = addPoints(result, window_sum);
         }
     }
 
+    return toAffine(result);
+}
+
+void EllipticCurve::setEndomorphism(const GlvParameters& parameters) {
+    const BigNum& mod = _f->modulo();
+    const BigNum& n = parameters.order;
+    const auto is_cube_root = [](const BigNum& root, const BigNum& m) {
+        return root % m != 1_bn && multiply(multiply(root, root, m), root, m) == 1_bn;
+    };
+    if (_shape != Shape::AZero)
+        throw std::invalid_argument("GLV endomorphism needs curve with A = 0.");
+    if (!is_cube_root(parameters.beta, mod) || !is_cube_root(parameters.lambda, n))
+        throw std::invalid_argument("Beta and lambda must be non trivial cube roots of unity.");
+
+    ///each beta matches one of the two lambdas, a wrong pair makes GLV return wrong multiples.
+    ///multiScalarMul never takes the GLV path, so the check holds when parameters are replaced
+    const Point& p = parameters.point;
+    if (p == neutral || !contains(p) || !(multiScalarMul({ p }, { n }) == neutral))
+        throw std::invalid_argument("Check point must be a point of order of the group.");
+    ///GLV reduces scalars modulo order, which is right only if every point lies in the group.
+    ///order divides #E <= q + 1 + 2 * sqrt(q), so order above half of the bound leaves #E = order
+    const BigNum hasse_bound = mod + 1_bn + 2_bn * (isqrt(mod) + 1_bn);
+    if (n > hasse_bound || n + n <= hasse_bound)
+        throw std::invalid_argument("GLV endomorphism needs cofactor 1.");
+    if (!(multiScalarMul({ p }, { parameters.lambda }) == Point(multiply(parameters.beta, p.x, mod), p.y)))
+        throw std::invalid_argument("Beta and lambda do not match.");
+
+    ///extended Euclid on (n, lambda) keeps r_i = s_i * n + t_i * lambda,
+    ///stop at the first r_(l + 1) < sqrt(n)
+    const BigNum sqrt_n = isqrt(n);
+    BigNum r_prev = n;
+    BigNum r = parameters.lambda % n;
+    Signed t_prev = { 0_bn, false };
+    Signed t = { 1_bn, false };
+    const auto step = [&] {
+        const BigNum q = r_prev / r;
+        BigNum r_next = r_prev - q * r;
+        Signed t_next = signedSubtract(t_prev, signedMultiply({ q, false }, t));
+        r_prev = r;
+        r = r_next;
+        t_prev = t;
+        t = t_next;
+    };
+    while (r >= sqrt_n)
+        step();
+
+    ///(a1, b1) = (r_(l + 1), -t_(l + 1)), (a2, b2) is the shorter of (r_l, -t_l) and (r_(l + 2), -t_(l + 2))
+    const BigNum r_l = r_prev;
+    const Signed t_l = t_prev;
+    _glv_basis.a1 = r;
+    _glv_basis.b1 = normalized({ t.first, !t.second });
+    step();
+    if (r_l * r_l + t_l.first * t_l.first <= r * r + t.first * t.first) {
+        _glv_basis.a2 = r_l;
+        _glv_basis.b2 = normalized({ t_l.first, !t_l.second });
+    } else {
+        _glv_basis.a2 = r;
+        _glv_basis.b2 = normalized({ t.first, !t.second });
+    }
+
+    _glv = parameters;
+}
+
+std::pair<std::pair<BigNum, bool>, std::pair<BigNum, bool>> EllipticCurve::_glvDecompose(const BigNum& a) const {
+    const BigNum& n = _glv->order;
+    const BigNum half_n = n / 2_bn;
+
+    ///c1 = round(b2 * a / n), c2 = round(-b1 * a / n)
+    const Signed c1 = normalized({ (_glv_basis.b2.first * a + half_n) / n, _glv_basis.b2.second });
+    const Signed c2 = normalized({ (_glv_basis.b1.first * a + half_n) / n, !_glv_basis.b1.second });
+
+    ///k1 = a - c1 * a1 - c2 * a2, k2 = -c1 * b1 - c2 * b2
+    Signed k1 = signedSubtract({ a, false }, signedMultiply(c1, { _glv_basis.a1, false }));
+    k1 = signedSubtract(k1, signedMultiply(c2, { _glv_basis.a2, false }));
+    Signed k2 = signedSubtract({ 0_bn, false }, signedMultiply(c1, _glv_basis.b1));
+    k2 = signedSubtract(k2, signedMultiply(c2, _glv_basis.b2));
+
+    return { k1, k2 };
+}
+
+const std::optional<GlvParameters>& EllipticCurve::getEndomorphism() const {
+    return _glv;
+}
+
+void EllipticCurve::setSecretScalarMode(SecretScalarMode mode) {
+    _secret_scalar_mode = mode;
+}
+
+EllipticCurve::SecretScalarMode EllipticCurve::getSecretScalarMode() const {
+    return _secret_scalar_mode;
+}
+
+std::vector<uint8_t> EllipticCurve::encodePoint(const Point& p, bool compressed) const {
+    if (p == neutral)
+        return { 0x00 };
+
+    const int length = _f->byteLength();
+    std::vector<uint8_t> result;
+    const auto x = toBytes(p.x, length);
+    if (compressed) {
+        result.push_back(p.y % 2_bn == 0_bn ? 0x02 : 0x03);
+        result.insert(result.end(), x.begin(), x.end());
+    } else {
+        const auto y = toBytes(p.y, length);
+        result.push_back(0x04);
+        result.insert(result.end(), x.begin(), x.end());
+        result.insert(result.end(), y.begin(), y.end());
+    }
+    return result;
+}
+
+Point EllipticCurve::decodePoint(const std::vector<uint8_t>& bytes) const {
+    if (bytes.size() == 1 && bytes[0] == 0x00)
+        return neutral;
+
+    const BigNum& mod = _f->modulo();
+    const int length = _f->byteLength();
+    const auto coordinate = [&](int index) {
+        BigNum value = fromBytes({ bytes.begin() + 1 + index * length, bytes.begin() + 1 + (index + 1) * length });
+        if (value >= mod)
+            throw std::invalid_argument("Coordinate is out of field.");
+        return value;
+    };
+
+    if (bytes.size() == 1 + 2 * length && bytes[0] == 0x04) {
+        Point p(coordinate(0), coordinate(1));
+        if (!contains(p))
+            throw std::invalid_argument("Point is not on the curve.");
+        return p;
+    }
+
+    if (bytes.size() != 1 + length || (bytes[0] != 0x02 && bytes[0] != 0x03))
+        throw std::invalid_argument("Malformed point encoding.");
+
+    const BigNum x = coordinate(0);
+    ///y^2 = x^3 + A*x + B
+    const BigNum rhs = add(multiply(add(multiply(x, x, mod), _a, mod), x, mod), _b, mod);
+    if (rhs == 0_bn) {
+        if (bytes[0] != 0x02)
+            throw std::invalid_argument("Point is not on the curve.");
+        return { x, 0_bn };
+    }
+
+    const auto root = _f->sqrt(rhs);
+    if (!root)
+        throw std::invalid_argument("Point is not on the curve.");
+
+    const bool odd = bytes[0] == 0x03;
+    return { x, (*root % 2_bn == 1_bn) == odd ? *root : mod - *root };
+}
+
 BigNum EllipticCurve::getFieldModulo() const{
-    return _f->modulo;
+    return _f->modulo();
 }
 
-    BigNum EllipticCurve::pointOrder(const Point& p) const {
+const std::shared_ptr<const Field>& EllipticCurve::getField() const {
+    return _f;
+}
 
-        // Calculate Q = (q + 1) * p
+EllipticCurve::Shape EllipticCurve::getShape() const {
+    return _shape;
+}
 
-        Point Q = powerPoint(p, _f->modulo + 1_bn);
+BigNum EllipticCurve::pointOrder(const Point& p, std::size_t max_baby_steps) const {
+    const BigNum& mod = _f->modulo();
 
-        BigNum m = sqrt(sqrt(_f->modulo)) + 1_bn;
+    ///baby steps j * p for j = 1 .. b keyed by x, so one lookup matches both j * p and -j * p
+    std::size_t baby_steps = std::stoull(to_string(iroot(mod, 4) + 1_bn));
+    if (max_baby_steps > 0)
+        baby_steps = std::min(baby_steps, max_baby_steps);
 
-        std::vector<Point> calculated_points;
+    std::unordered_map<BigNum, std::pair<std::size_t, BigNum>> baby_steps_by_x;
+    baby_steps_by_x.reserve(baby_steps);
+    Point baby = p;
+    for (std::size_t j = 1; j <= baby_steps; ++j) {
+        if (baby == neutral)
+            return BigNum(std::to_string(j));
+        baby_steps_by_x.emplace(baby.x, std::make_pair(j, baby.y));
+        baby = addPoints(baby, p);
+    }
 
-        // Calculate and store points i * p for i = 1 .. m, where m = [modulo ^ (1/4)]
+    ///order N = q + 1 + s with |s| <= 2 * sqrt(q), write s = k * (2b + 1) + r with |r| <= b:
+    ///then (q + 1) * p + k * G = -r * p for giant step G = (2b + 1) * p
+    const BigNum step(std::to_string(2 * baby_steps + 1));
+    const BigNum giant_steps = (2_bn * isqrt(mod) + 2_bn) / step + 1_bn;
+    const Point giant = powerPoint(p, step);
 
-        Point point = p;
-        for (BigNum i = 1_bn; i <= m; i = i + 1_bn){
-            calculated_points.push_back(point);
-            point = addPoints(point, p);
+    ///k goes from -giant_steps up, every next giant step is a single addition
+    Point current = addPoints(powerPoint(p, mod + 1_bn), invertedPoint(powerPoint(giant, giant_steps)));
+    for (BigNum i = 0_bn; i <= 2_bn * giant_steps; i = i + 1_bn) {
+        ///candidate q + 1 + k * (2b + 1) + r with k = i - giant_steps, kept as positive - negative
+        BigNum positive = mod + 1_bn + i * step;
+        BigNum negative = giant_steps * step;
+        bool found = false;
+        if (current == neutral) {
+            found = true;
+        } else if (const auto it = baby_steps_by_x.find(current.x); it != baby_steps_by_x.end()) {
+            ///current = j * p means r = -j, current = -j * p means r = j
+            const BigNum j(std::to_string(it->second.first));
+            if (current.y == it->second.second)
+                negative = negative + j;
+            else
+                positive = positive + j;
+            found = true;
         }
 
-        bool negative = true;
-        point = powerPoint(p, 2_bn * m);
-        Point right_part(0_bn, 0_bn);
-        BigNum k = m;
-        BigNum M;
+        if (found && positive > negative) {
+            BigNum multiple = positive - negative;
+            return reduce(multiple, p);
+        }
+        current = addPoints(current, giant);
+    }
+    throw std::logic_error("Point order is not found, point is not on the curve or modulo is not prime.");
+}
+
+BigNum EllipticCurve::reduce(BigNum& M, const Point& p) const {
+    ///M < 2q, so above q^(1/4) it has three prime factors at most and rho finds each in O(q^(1/4)) steps
+    for (const auto& [prime, exponent] : factorized(M, iroot(M, 4) + 1_bn)) {
+        for (int i = 0; i < exponent && powerPoint(p, M / prime) == neutral; ++i)
+            M = M / prime;
+    }
 
-        // calculate new point: result = Q + right_part
-        // where right_part = k * (2 * m * p)
-        // for k = -m, - m + 1, ..., -1, 0, 1, ..., m - 1, m
+    return M;
+}
 
-        while (true){
+BigNum EllipticCurve::countPoints() const {
+    const BigNum& mod = _f->modulo();
+    const BigNum a = _a % mod;
+    const BigNum b = _b % mod;
 
-            if (negative){
-                right_part = invertedPoint(powerPoint(point, k));
-            } else {
-                right_part = powerPoint(point, k);
-            }
+    ///#E = p + 1 + sum of Legendre symbols (x^3 + A*x + B / p) over all x
+    if (_f->bitLength() < SCHOOF_MIN_BITS) {
+        BigNum residues = 0_bn;
+        BigNum non_residues = 0_bn;
+        for (BigNum x = 0_bn; x < mod; x = x + 1_bn) {
+            const int symbol = jacobi(x * x * x + a * x + b, mod);
+            if (symbol == 1)
+                residues = residues + 1_bn;
+            else if (symbol == -1)
+                non_residues = non_residues + 1_bn;
+        }
+        return mod + 1_bn + residues - non_residues;
+    }
 
-            Point result = addPoints(Q, right_part);
-
-            // check if calculated point result is equal to saved point or ist inverted
-            // (result i * p or - i * p)
-            // if yes then Q + k * (2 * m * p) = (+-) i * p, hence (while Q = (modulo + 1) * p)
-            // ( modulo + 1 + k * (2 * m) (-+) i ) * p = neutral
-            // so we get that order is divisor of M = modulo + 1 + k * (2 * m) (-+) i
-            BigNum index = 1_bn;
-            for (const auto& i : calculated_points){
-
-                if (result == i){
-                    M = negative ? (_f->modulo + 1_bn - 2_bn * m * k - index) :
-                                    (_f->modulo + 1_bn + 2_bn * m * k - index);
-                    return reduce(M, p); // return function which finds divisor which is order
-                } else if (result == invertedPoint(i)){
-                    M = negative ? (_f->modulo + 1_bn - 2_bn * m * k + index) :
-                        (_f->modulo + 1_bn + 2_bn * m * k + index);
-                    return reduce(M, p); // return function which finds divisor which is order
-                }
+    ///Schoof: #E = p + 1 - t with |t| <= 2 * sqrt(p), t is restored from its residues
+    ///modulo small primes l with product above 4 * sqrt(p)
+    const Polynomial rhs(_f, { b, a, 0_bn, 1_bn });
+    const Polynomial x = Polynomial::monomial(_f, 1);
+    const BigNum bound = 4_bn * (isqrt(mod) + 1_bn);
 
-                index = index + 1_bn;
-            }
+    ///t is even iff there is a point of order 2, that is x^3 + A*x + B has a root: gcd(x^p - x, rhs) != 1
+    const Polynomial x_powered = PolynomialModulus(rhs).pow(x, mod);
+    BigNum trace = gcd(x_powered - x, rhs).degree() > 0 ? 0_bn : 1_bn;
+    BigNum product = 2_bn;
 
-            if (negative){
-                k = k - 1_bn;
-                if (k == 0_bn) negative = false;
+    ///division polynomials f_n: psi_n for odd n and psi_n / (2 * y) for even n, so y appears
+    ///only as (2 * y)^4 = 16 * rhs^2 in the recurrences
+    const Polynomial rhs_squared = rhs * rhs * 16_bn;
+    const auto negated = [&](const BigNum& num) { return subtract(0_bn, num % mod, mod); };
+    std::vector<Polynomial> division = {
+        Polynomial(_f),
+        Polynomial(_f, { 1_bn }),
+        Polynomial(_f, { 1_bn }),
+        Polynomial(_f, { negated(a * a), 12_bn * b, 6_bn * a, 0_bn, 3_bn }),
+        Polynomial(_f, { negated(16_bn * b * b + 2_bn * a * a * a), negated(8_bn * a * b), negated(10_bn * a * a),
+                         40_bn * b, 10_bn * a, 0_bn, 2_bn })
+    };
+    const auto divisionPolynomial = [&](int n) {
+        while (division.size() <= n) {
+            const int k = division.size();
+            const int m = k / 2;
+            if (k % 2 == 1) {
+                Polynomial first = division[m + 2] * division[m] * division[m] * division[m];
+                Polynomial second = division[m - 1] * division[m + 1] * division[m + 1] * division[m + 1];
+                if (m % 2 == 0)
+                    first = first * rhs_squared;
+                else
+                    second = second * rhs_squared;
+                division.push_back(first - second);
             } else {
-                k = k + 1_bn;
+                division.push_back(division[m] * (division[m + 2] * division[m - 1] * division[m - 1] -
+                                                  division[m - 2] * division[m + 1] * division[m + 1]));
             }
         }
+        return division[n];
+    };
+
+    const auto isPrime = [](int num) {
+        for (int d = 2; d * d <= num; ++d)
+            if (num % d == 0)
+                return false;
+        return true;
+    };
+    for (int l = 3; product <= bound; l += 2) {
+        if (!isPrime(l))
+            continue;
+
+        const int residue = frobeniusTrace(l, divisionPolynomial(l).monic(), rhs, a);
+
+        ///CRT: trace + product * h = residue (mod l)
+        const BigNum l_num(std::to_string(l));
+        const int product_residue = std::stoi(to_string(product % l_num));
+        const int trace_residue = std::stoi(to_string(trace % l_num));
+        int h = 0;
+        while ((trace_residue + product_residue * h) % l != residue)
+            ++h;
+        trace = trace + product * BigNum(std::to_string(h));
+        product = product * l_num;
     }
 
-    BigNum EllipticCurve::reduce(BigNum& M, const Point& p) const {
-        auto divisors = factorization(M);
+    ///trace above product / 2 stands for negative t = trace - product
+    if (trace > product / 2_bn)
+        return mod + 1_bn + (product - trace);
+    return mod + 1_bn - trace;
+}
 
-        bool all_not_infinity = true;
-        while (all_not_infinity){
-            all_not_infinity = false;
-            for (auto& div : divisors){
-                if (div.second > 0_bn && powerPoint(p, M/div.first) == neutral){
-                    div.second = div.second - 1_bn;
-                    all_not_infinity = true;
-                    M = M/div.first;
-                } else div.second = 0_bn;
-            }
+FixedBaseTable::FixedBaseTable(const EllipticCurve& curve, const Point& generator, int max_scalar_bits, int window)
+    : _curve(curve), _generator(generator), _window(window),
+      _max_scalar_bits(max_scalar_bits > 0 ? max_scalar_bits : curve.getField()->bitLength() + 1)
+{
+    if (window < 1)
+        throw std::invalid_argument("Window must be positive.");
+
+    const int rows = (_max_scalar_bits + window - 1) / window;
+    const int row_size = (1 << window) - 1;
+    _table.resize(rows);
+
+    ///2^(window * i) * generator, all multiples are normalized together at the end
+    std::vector<JacobianPoint> multiples;
+    multiples.reserve(rows * row_size);
+    JacobianPoint row_base = _curve.toJacobian(generator);
+    for (int i = 0; i < rows; ++i) {
+        JacobianPoint multiple = row_base;
+        for (int d = 1; d <= row_size; ++d) {
+            multiples.push_back(multiple);
+            multiple = _curve.addPoints(multiple, row_base);
         }
+        row_base = multiple;
+    }
 
-        return M;
+    const auto affine = _curve.normalizeBatch(multiples);
+    for (int i = 0; i < rows; ++i) {
+        _table[i].reserve(row_size);
+        for (int d = 0; d < row_size; ++d)
+            _table[i].push_back(_curve.toJacobian(affine[i * row_size + d]));
     }
+}
 
-    BigNum EllipticCurve::countPoints() const {
-        BigNum left = _f->modulo + 1_bn - 2_bn * sqrt(_f->modulo);
-        BigNum right = _f->modulo + 1_bn + 2_bn * sqrt(_f->modulo);
-        BigNum lcm = 1_bn;
-        BigNum x = 1_bn;
-        std::cout << left << " " << right <<  "\n";
-        while (!(left <= lcm && lcm <= right)){
-            while (!sqrt(x * x * x + x * _a + _b, _f->modulo) ||
-                   !contains(Point(x, sqrt(x * x * x + x * _a + _b, _f->modulo)->second))){
-                x = x + 1_bn;
-            }
-            Point point = Point(x, sqrt(x * x * x + x * _a + _b, _f->modulo)->second);
-            if (contains(point)) {
-                BigNum point_order = pointOrder(point);
-                lcm = point_order * lcm / gcd(point_order, lcm);
-            }
+Point FixedBaseTable::multiplyGenerator(const BigNum& scalar) const {
+    const auto bits = toBinary(scalar);
+    if (bits.size() > _max_scalar_bits)
+        return _curve.powerPoint(_generator, scalar);
+
+    JacobianPoint result = _curve.toJacobian(EllipticCurve::neutral);
+    for (int i = 0; i * _window < bits.size(); ++i) {
+        int value = 0;
+        for (int bit = std::min<int>(bits.size(), (i + 1) * _window) - 1; bit >= i * _window; --bit)
+            value = value * 2 + bits[bit];
+        if (value != 0)
+            result = _curve.addPoints(result, _table[i][value - 1]);
+    }
+    return _curve.toAffine(result);
+}
+
+const Point& FixedBaseTable::getGenerator() const {
+    return _generator;
+}
+
+const EllipticCurve& FixedBaseTable::getCurve() const {
+    return _curve;
+}
 
-            std::cout << lcm;
+PublicKeyCache::PublicKeyCache(const EllipticCurve& curve, std::optional<BigNum> subgroup_order, std::size_t capacity)
+    : _curve(curve), _subgroup_order(std::move(subgroup_order)), _capacity(capacity) {}
+
+Point PublicKeyCache::validate(const std::vector<uint8_t>& encoded) const {
+    const std::string key(encoded.begin(), encoded.end());
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        if (const auto it = _validated.find(key); it != _validated.end())
+            return it->second;
+    }
+
+    ///decoding and validation run unlocked, two threads may validate the same key at once
+    const Point p = _curve.decodePoint(encoded);
+    if (!_curve.isValidPublicKey(p, _subgroup_order))
+        throw std::invalid_argument("Public key is not valid.");
+
+    const std::lock_guard<std::mutex> lock(_mutex);
+    if (_capacity > 0 && _validated.emplace(key, p).second) {
+        _order.push_back(key);
+        if (_order.size() > _capacity) {
+            _validated.erase(_order.front());
+            _order.pop_front();
         }
-        return lcm;
     }
-}
\ No newline at end of file
+    return p;
+}
+
+std::size_t PublicKeyCache::size() const {
+    const std::lock_guard<std::mutex> lock(_mutex);
+    return _validated.size();
+}
+
+const EllipticCurve& PublicKeyCache::getCurve() const {
+    return _curve;
+}
+
+} // namespace lab
@@ -1,6 +1,14 @@
 #pragma once
 
 #include "BigNum.hpp"
+#include "Field.hpp"
+#include "FieldElement.hpp"
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 
@@ -16,20 +24,52 @@ struct Point {
     }
 };
 
-struct Field {
-    BigNum modulo;
-    Field(const BigNum& g) :modulo(g) {}
+/**
+ * @brief Point in Jacobian coordinates, (x, y, z) stands for affine (x / z^2, y / z^3),
+ *        any point with z = 0 is the neutral one. Coordinates stay field elements between
+ *        operations, plain BigNums appear only in Point
+ */
+struct JacobianPoint {
+    FieldElement x;
+    FieldElement y;
+    FieldElement z;
 
-    friend bool operator==(const Field& left, const Field& right) {
-        return left.modulo == right.modulo;
-    }
+    JacobianPoint(const FieldElement& X, const FieldElement& Y, const FieldElement& Z) :x(X), y(Y), z(Z) {}
+};
+
+/**
+ * @brief Endomorphism (x, y) -> (beta * x, y) of curve with A = 0 over p = 1 (mod 3),
+ *        which acts on the group as multiplication by lambda (GLV method)
+ */
+struct GlvParameters {
+    BigNum beta;   ///< non trivial cube root of unity modulo field modulo
+    BigNum lambda; ///< non trivial cube root of unity modulo order, matching beta
+    BigNum order;  ///< prime order of the group, must be the number of points on the curve (cofactor 1)
+    Point point;   ///< point of the group other than neutral, checks that beta matches lambda
 };
 
 class EllipticCurve {
 public:
+    /**
+     * @brief Curves with A = 0 (secp256k1) or A = -3 (NIST curves) have cheaper doubling
+     */
+    enum class Shape {
+        Generic,
+        AZero,
+        AMinusThree
+    };
+
+    /**
+     * @brief Scalar multiplication used by powerPointSecret
+     */
+    enum class SecretScalarMode {
+        WindowedNaf, ///< fastest, timing depends on scalar
+        Ladder       ///< Montgomery ladder, same operation sequence for every scalar of given length
+    };
+
     EllipticCurve(const EllipticCurve& that) = default;
 
-    EllipticCurve(Field* f, const BigNum& a, const BigNum& b);
+    EllipticCurve(std::shared_ptr<const Field> f, const BigNum& a, const BigNum& b);
 
     EllipticCurve() = default;
 
@@ -45,48 +85,266 @@ public:
 
     /**
     * @return True if elliptic curve contains given point, otherwise false
+    * @note Computed with reduced multiplications of field elements, coordinates are taken modulo field modulo
     */
     bool contains(const Point& p) const;
 
+    /**
+    * @brief Validation of peer public key: not neutral, coordinates below modulo, on the curve
+    *        and, if subgroup_order is given, subgroup_order * p is neutral (needed for cofactor > 1)
+    */
+    bool isValidPublicKey(const Point& p, const std::optional<BigNum>& subgroup_order = std::nullopt) const;
+
     /**
     * @param Point p must belong to curve
     */
     Point invertedPoint(const Point& p) const;
 
+    /**
+    * @brief Negation in Jacobian coordinates, (x, y, z) -> (x, -y, z)
+    */
+    JacobianPoint invertedPoint(const JacobianPoint& p) const;
+
     //TODO: fix namespace issue
     /**
     * @param Both points should belong to curve
     */
     Point addPoints(const Point& first, const Point& second) const;
 
+    /**
+    * @brief Adds first[i] + second[i] for every i sharing one inversion between all lanes,
+    *        lanes with neutral, opposite or equal points are handled as in addPoints
+    * @param first and second must be of the same size, out gets the sums
+    */
+    void addPointsBatch(const std::vector<Point>& first, const std::vector<Point>& second, std::vector<Point>& out) const;
+
+    /**
+    * @brief Addition in Jacobian coordinates, no inversions; points with z = 1 take mixed addition
+    */
+    JacobianPoint addPoints(const JacobianPoint& first, const JacobianPoint& second) const;
+
+    /**
+    * @brief Mixed addition of Jacobian and affine points, cheaper than addition of two Jacobian points
+    */
+    JacobianPoint addPoints(const JacobianPoint& first, const Point& second) const;
+
+    JacobianPoint doublePoint(const JacobianPoint& p) const;
+
+    JacobianPoint toJacobian(const Point& p) const;
+
+    /**
+    * @brief Converts point back to affine coordinates, costs one inversion
+    */
+    Point toAffine(const JacobianPoint& p) const;
+
+    /**
+    * @brief Converts all points to affine coordinates sharing one inversion (Montgomery's trick)
+    */
+    std::vector<Point> normalizeBatch(const std::vector<JacobianPoint>& points) const;
+
+    /**
+    * @brief Calculates a * p by iterative width-w NAF in Jacobian coordinates,
+    *        converting to affine only once at the end
+    */
     Point powerPoint(const Point& p, const BigNum& a) const;
 
+    /**
+    * @brief Montgomery ladder on x-coordinates (Brier–Joye formulas) with y recovered at the end (Okeya–Sakurai).
+    *        Runs one differential addition and one doubling for each of max(bits of a, bits of modulo + 1) bits.
+    */
+    Point powerPointLadder(const Point& p, const BigNum& a) const;
+
+    /**
+    * @brief Calculates a * p for secret scalar a with the algorithm chosen by setSecretScalarMode
+    */
+    Point powerPointSecret(const Point& p, const BigNum& a) const;
+
+    /**
+    * @brief Calculates sum of scalars[i] * points[i] sharing doublings between all terms:
+    *        Shamir's trick for two points, interleaved NAF (Straus) for a few, buckets (Pippenger) for many
+    * @param points and scalars must be of the same size
+    */
+    Point multiScalarMul(const std::vector<Point>& points, const std::vector<BigNum>& scalars) const;
+
+    /**
+    * @brief Makes powerPoint split scalars into two half-length ones by GLV decomposition
+    * @throws std::invalid_argument if curve has A != 0, parameters are not cube roots of unity,
+    *         point is not of prime order, order is not the number of points on the curve
+    *         or lambda * point != (beta * x, y)
+    */
+    void setEndomorphism(const GlvParameters& parameters);
+
+    const std::optional<GlvParameters>& getEndomorphism() const;
+
+    void setSecretScalarMode(SecretScalarMode mode);
+
+    SecretScalarMode getSecretScalarMode() const;
+
+    /**
+    * @brief SEC1 encoding: 0x00 for neutral, 0x02/0x03 || x for compressed (prefix keeps parity of y),
+    *        0x04 || x || y for uncompressed; coordinates take bytes of modulo each
+    */
+    std::vector<uint8_t> encodePoint(const Point& p, bool compressed = true) const;
+
+    /**
+    * @brief Decodes SEC1 point, compressed y is recovered as square root of x^3 + A*x + B
+    * @throws std::invalid_argument if encoding is malformed or point is not on the curve
+    */
+    Point decodePoint(const std::vector<uint8_t>& bytes) const;
+
     BigNum getFieldModulo() const;
 
-    ///< y^2 = x^3 + a*x + b on field f
-    BigNum pointOrder(const Point& p) const;
+    const std::shared_ptr<const Field>& getField() const;
+
+    Shape getShape() const;
+
+    /**
+    * @brief Order of point by baby-step giant-step over the Hasse interval: baby steps j * p
+    *        are hashed by x, giant steps are single additions, so it takes O(q^(1/4)) additions
+    * @param max_baby_steps memory budget, limits stored baby steps (0 - no limit);
+    *        fewer baby steps mean proportionally more giant steps
+    */
+    BigNum pointOrder(const Point& p, std::size_t max_baby_steps = 0) const;
 
     /**
-    * @return count of points on curve
+    * @brief Counts points by Schoof's algorithm: trace of Frobenius modulo small primes l
+    *        from l-torsion arithmetic modulo division polynomials, combined by CRT.
+    *        Fields below SCHOOF_MIN_BITS bits are counted directly with Legendre symbols
+    * @return count of points on curve, neutral included
     */
     BigNum countPoints() const;
 
 private:
 
     /**
-     * @brief Takes BigNum n, Point P such that nP == infinity and finds minimal order for Point
+     * @brief Takes BigNum n, Point P such that nP == infinity and finds minimal order for Point.
+     *        n is factored by trial division up to n^(1/4) and Pollard's rho for the rest
      * */
     BigNum reduce(BigNum& num, const Point& p) const;
 
-    /// y^2 = x^3 + a*x + b on field f
-    Field* _f;
+    /**
+     * @brief Numerator of the tangent slope 3*x^2 + A*z^4, computed by the cheapest formula for the shape
+     */
+    FieldElement _tangentNumerator(const FieldElement& x, const FieldElement& z) const;
+
+    /**
+     * @brief Mixed addition of Jacobian point and affine point (x2, y2), which must not be neutral
+     */
+    JacobianPoint _addMixed(const JacobianPoint& first, const FieldElement& x2, const FieldElement& y2) const;
+
+    /**
+     * @brief Swaps points if bit is set, single place to harden branch-free ladder later
+     */
+    template<typename PointType>
+    static void _conditionalSwap(bool bit, PointType& first, PointType& second);
+
+    /**
+     * @brief Ladder in Jacobian coordinates for points with x = 0, where x-only addition degenerates
+     */
+    Point _powerPointLadderJacobian(const Point& p, const std::vector<char>& bits) const;
+
+    /**
+     * @brief Splits a into k1 + k2 * lambda (mod order) with |k1|, |k2| about sqrt(order)
+     * @return Pairs of absolute value and sign: {k1, k1 < 0}, {k2, k2 < 0}
+     */
+    std::pair<std::pair<BigNum, bool>, std::pair<BigNum, bool>> _glvDecompose(const BigNum& a) const;
+
+    /**
+     * @brief Short basis (a1, b1), (a2, b2) of lattice {(x, y) : x + y * lambda = 0 (mod order)},
+     *        a1 and a2 are non negative, b1 and b2 are stored as absolute value and sign
+     */
+    struct _GlvBasis {
+        BigNum a1;
+        std::pair<BigNum, bool> b1;
+        BigNum a2;
+        std::pair<BigNum, bool> b2;
+    };
+
+    /// y^2 = x^3 + a*x + b on field f, shared by all copies of the curve
+    std::shared_ptr<const Field> _f;
     BigNum _a;
     BigNum _b;
+    /// a, b and 1 as elements of field f
+    FieldElement _a_element;
+    FieldElement _b_element;
+    FieldElement _one;
+    Shape _shape = Shape::Generic;
+    SecretScalarMode _secret_scalar_mode = SecretScalarMode::Ladder;
+    std::optional<GlvParameters> _glv;
+    _GlvBasis _glv_basis;
+};
+
+/**
+ * @brief Precomputed multiples of a fixed generator: d * 2^(window * i) * g for every window position i
+ *        and window value d, so multiplyGenerator() costs one mixed addition per non zero window and no doublings.
+ *        Memory is about (max_scalar_bits / window) * 2^window points.
+ * @note Object is immutable after construction, so it can be shared between threads
+ */
+class FixedBaseTable {
+public:
+    /**
+     * @param max_scalar_bits bit length of the biggest expected scalar, bit length of modulo + 1 if 0
+     */
+    FixedBaseTable(const EllipticCurve& curve, const Point& generator, int max_scalar_bits = 0, int window = 4);
+
+    /**
+     * @brief Calculates scalar * generator
+     * @note Scalars longer than max_scalar_bits fall back to EllipticCurve::powerPoint
+     */
+    Point multiplyGenerator(const BigNum& scalar) const;
+
+    const Point& getGenerator() const;
+
+    const EllipticCurve& getCurve() const;
+
+private:
+    EllipticCurve _curve;
+    Point _generator;
+    int _window;
+    int _max_scalar_bits;
+    /// _table[i][d - 1] = d * 2^(window * i) * generator normalized to z = 1, so additions are mixed
+    std::vector<std::vector<JacobianPoint>> _table;
+};
+
+/**
+ * @brief Decodes and validates SEC1 encoded peer public keys, remembering keys which passed by their encoding,
+ *        so repeated handshakes with the same peer skip decompression and validation.
+ *        Keeps at most capacity keys, the oldest one is forgotten first
+ * @note validate() is thread safe, so one cache can be shared between clients
+ */
+class PublicKeyCache {
+public:
+    /**
+     * @param subgroup_order enables subgroup check of EllipticCurve::isValidPublicKey
+     */
+    PublicKeyCache(const EllipticCurve& curve, std::optional<BigNum> subgroup_order = std::nullopt,
+                   std::size_t capacity = 1024);
+
+    PublicKeyCache(const PublicKeyCache&) = delete;
+    PublicKeyCache& operator=(const PublicKeyCache&) = delete;
+
+    /**
+     * @throws std::invalid_argument if encoding is malformed or key is not valid
+     */
+    Point validate(const std::vector<uint8_t>& encoded) const;
+
+    std::size_t size() const;
+
+    const EllipticCurve& getCurve() const;
+
+private:
+    EllipticCurve _curve;
+    std::optional<BigNum> _subgroup_order;
+    std::size_t _capacity;
+    mutable std::mutex _mutex;
+    mutable std::unordered_map<std::string, Point> _validated;
+    /// encodings in order of validation, the front is evicted first
+    mutable std::deque<std::string> _order;
 };
 
 template<typename OStream>
 OStream& operator<<(OStream& os, const EllipticCurve& curve) {
-    os << "y^2 = x^3 + " << curve._a << "*x + " << curve._b << " mod " << curve._f->modulo;
+    os << "y^2 = x^3 + " << curve._a << "*x + " << curve._b << " mod " << curve._f->modulo();
     return os;
 }
 
@@ -0,0 +1,169 @@
+#include <Field.hpp>
+
+#include <stdexcept>
+
+namespace lab {
+
+namespace {
+/// members of Field hide the free functions of the same names, these forward to them
+int bitsOf(const BigNum& num) {
+    return bitLength(num);
+}
+
+BigNum multiplyModulo(const BigNum& left, const BigNum& right, const BigNum& mod) {
+    return multiply(left, right, mod);
+}
+
+/**
+ * @brief Miller–Rabin test of odd num > 2 with the first 12 primes as bases
+ */
+bool isProbablePrime(const BigNum& num) {
+    if (num % 5_bn == 0_bn)
+        return num == 5_bn;
+
+    const MontgomeryContext context(num);
+    const BigNum num_minus_one = num - 1_bn;
+    BigNum odd_part = num_minus_one;
+    int twos = 0;
+    while (odd_part % 2_bn == 0_bn) {
+        odd_part = odd_part / 2_bn;
+        ++twos;
+    }
+
+    for (const auto& base : { 2_bn, 3_bn, 5_bn, 7_bn, 11_bn, 13_bn, 17_bn, 19_bn, 23_bn, 29_bn, 31_bn, 37_bn }) {
+        if (base >= num)
+            break;
+        BigNum x = context.pow(base, odd_part);
+        if (x == 1_bn || x == num_minus_one)
+            continue;
+        bool witness = true;
+        for (int i = 1; i < twos && witness; ++i) {
+            x = multiplyModulo(x, x, num);
+            witness = x != num_minus_one;
+        }
+        if (witness)
+            return false;
+    }
+    return true;
+}
+} // <anonymous> namespace
+
+Field::Field(const BigNum& modulo)
+    : _modulo(modulo), _bit_length(bitsOf(modulo)) {
+    if (_modulo < 3_bn || _modulo % 2_bn == 0_bn)
+        throw std::invalid_argument("Field modulo must be odd and greater than 2.");
+
+    _modulo_multiples.push_back(_modulo);
+    while (_modulo_multiples.size() < MAX_LAZY_BITS)
+        _modulo_multiples.push_back(_modulo_multiples.back() + _modulo_multiples.back());
+
+    _is_prime = isProbablePrime(_modulo);
+    if (_modulo % 5_bn != 0_bn)
+        _montgomery.emplace(_modulo);
+
+    _odd_part = _modulo - 1_bn;
+    _two_adicity = 0;
+    while (_odd_part % 2_bn == 0_bn) {
+        _odd_part = _odd_part / 2_bn;
+        ++_two_adicity;
+    }
+
+    if (_two_adicity == 1) {
+        _sqrt_strategy = SqrtStrategy::ThreeModFour;
+    } else if (_two_adicity == 2) {
+        _sqrt_strategy = SqrtStrategy::Atkin;
+    } else if (prefersCipolla(_modulo, _two_adicity)) {
+        _sqrt_strategy = SqrtStrategy::Cipolla;
+    } else {
+        _sqrt_strategy = SqrtStrategy::TonelliShanks;
+        /// non-residue is looked for once, for prime modulo half of the candidates fit
+        for (BigNum z = 2_bn; _is_prime && z < _modulo; z = z + 1_bn) {
+            if (jacobi(z, _modulo) == -1) {
+                _non_residue_power = pow(z, _odd_part);
+                break;
+            }
+        }
+    }
+}
+
+const BigNum& Field::modulo() const noexcept {
+    return _modulo;
+}
+
+const BigNum& Field::moduloMultiple(int power) const noexcept {
+    return _modulo_multiples[power];
+}
+
+int Field::bitLength() const noexcept {
+    return _bit_length;
+}
+
+int Field::byteLength() const noexcept {
+    return (_bit_length + 7) / 8;
+}
+
+bool Field::isPrime() const noexcept {
+    return _is_prime;
+}
+
+const std::optional<MontgomeryContext>& Field::montgomery() const noexcept {
+    return _montgomery;
+}
+
+BigNum Field::reduce(const BigNum& num) const {
+    return num % _modulo;
+}
+
+BigNum Field::multiply(const BigNum& left, const BigNum& right) const {
+    return reduce(left * right);
+}
+
+BigNum Field::pow(const BigNum& base, const BigNum& degree) const {
+    if (_montgomery)
+        return _montgomery->pow(base, degree);
+
+    BigNum result = 1_bn;
+    const BigNum reduced = reduce(base);
+    const auto bits = toBinary(degree);
+    for (auto bit = bits.rbegin(); bit != bits.rend(); ++bit) {
+        result = multiply(result, result);
+        if (*bit == 1)
+            result = multiply(result, reduced);
+    }
+    return result;
+}
+
+BigNum Field::inverted(const BigNum& num) const {
+    if (num % _modulo == 0_bn)
+        throw std::invalid_argument("Zero has no inverse.");
+    return pow(num, _modulo - 2_bn);
+}
+
+Field::SqrtStrategy Field::getSqrtStrategy() const noexcept {
+    return _sqrt_strategy;
+}
+
+std::optional<BigNum> Field::sqrt(const BigNum& num) const {
+    if (!_is_prime)
+        throw std::logic_error("Square roots need prime modulo.");
+
+    const BigNum n = num % _modulo;
+    if (n == 0_bn)
+        return 0_bn;
+    if (jacobi(n, _modulo) != 1)
+        return std::nullopt;
+
+    switch (_sqrt_strategy) {
+    case SqrtStrategy::ThreeModFour:
+        return pow(n, (_modulo + 1_bn) / 4_bn);
+    case SqrtStrategy::Atkin:
+        return sqrtAtkin(n, _modulo);
+    case SqrtStrategy::TonelliShanks:
+        return sqrtTonelliShanks(n, _modulo, _odd_part, _two_adicity, _non_residue_power);
+    case SqrtStrategy::Cipolla:
+        return sqrtCipolla(n, _modulo);
+    }
+    return std::nullopt;
+}
+
+} // namespace lab
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "BigNum.hpp"
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace lab {
+
+/**
+ * @brief Immutable context of prime field: everything that depends on modulo only is calculated
+ *        once in constructor, curves and polynomials share it through std::shared_ptr<const Field>
+ */
+class Field {
+public:
+    /**
+     * @brief Square root algorithm chosen by p - 1 = q * 2^s
+     */
+    enum class SqrtStrategy {
+        ThreeModFour,  ///< s = 1: x = n^((p + 1) / 4)
+        Atkin,         ///< s = 2: Atkin's formula with (p - 5) / 8
+        TonelliShanks, ///< s > 2: Tonelli–Shanks with precomputed non-residue
+        Cipolla        ///< s > 2 with s^2 > 20 * log2(p): Cipolla's algorithm, see prefersCipolla
+    };
+
+    /**
+     * @brief Unreduced sums of field elements stay below modulo * 2^MAX_LAZY_BITS
+     */
+    static constexpr int MAX_LAZY_BITS = 4;
+
+    /**
+     * @throws std::invalid_argument if modulo is less than 3 or even
+     */
+    explicit Field(const BigNum& modulo);
+
+    Field(const Field&) = delete;
+    Field& operator=(const Field&) = delete;
+
+    friend bool operator==(const Field& left, const Field& right) {
+        return left._modulo == right._modulo;
+    }
+
+    const BigNum& modulo() const noexcept;
+
+    /**
+     * @return modulo * 2^power for power in [0, MAX_LAZY_BITS), reduces lazy sums by halves
+     */
+    const BigNum& moduloMultiple(int power) const noexcept;
+
+    int bitLength() const noexcept;
+
+    /**
+     * @return Number of bytes of modulo, length of serialized field element
+     */
+    int byteLength() const noexcept;
+
+    /**
+     * @brief Miller–Rabin test with the first 12 prime bases, calculated once: deterministic
+     *        for modulo below 3.3 * 10^24, probabilistic above
+     */
+    bool isPrime() const noexcept;
+
+    /**
+     * @return Montgomery constants, absent if modulo shares a factor with NUM_BASE
+     */
+    const std::optional<MontgomeryContext>& montgomery() const noexcept;
+
+    /**
+     * @brief Single entry point of reduction modulo modulo
+     */
+    BigNum reduce(const BigNum& num) const;
+
+    BigNum multiply(const BigNum& left, const BigNum& right) const;
+
+    BigNum pow(const BigNum& base, const BigNum& degree) const;
+
+    /**
+     * @brief Inversion by Fermat's little theorem, num must be non zero modulo prime modulo
+     */
+    BigNum inverted(const BigNum& num) const;
+
+    SqrtStrategy getSqrtStrategy() const noexcept;
+
+    /**
+     * @return One of the square roots of num, none if num is a non-residue.
+     *         Algorithms are shared with sqrt(num, mod) of BigNum
+     */
+    std::optional<BigNum> sqrt(const BigNum& num) const;
+
+private:
+    BigNum _modulo;
+    /// modulo * 2^i
+    std::vector<BigNum> _modulo_multiples;
+    int _bit_length;
+    bool _is_prime;
+    std::optional<MontgomeryContext> _montgomery;
+    /// p - 1 = _odd_part * 2^_two_adicity
+    BigNum _odd_part;
+    int _two_adicity;
+    SqrtStrategy _sqrt_strategy;
+    /// z^_odd_part for quadratic non-residue z, used by Tonelli–Shanks only
+    BigNum _non_residue_power;
+};
+
+} // namespace lab
@@ -0,0 +1,117 @@
+#include <FieldElement.hpp>
+
+#include <stdexcept>
+
+namespace lab {
+
+FieldElement::FieldElement(const Field& field, const BigNum& num) : _field(&field) {
+    const BigNum& mod = field.modulo();
+    const auto& montgomery = field.montgomery();
+    if (montgomery)
+        _value = montgomery->toMontgomery(num);
+    else
+        _value = num < mod ? num : field.reduce(num);
+}
+
+FieldElement FieldElement::zero(const Field& field) {
+    return { &field, 0_bn };
+}
+
+FieldElement FieldElement::one(const Field& field) {
+    const auto& montgomery = field.montgomery();
+    return { &field, montgomery ? montgomery->one() : 1_bn };
+}
+
+const Field& FieldElement::getField() const {
+    return *_field;
+}
+
+BigNum FieldElement::toBigNum() const {
+    const auto& montgomery = _field->montgomery();
+    return montgomery ? montgomery->fromMontgomery(_value) : _value;
+}
+
+bool FieldElement::isZero() const {
+    return _value == 0_bn;
+}
+
+FieldElement FieldElement::inverted() const {
+    if (isZero())
+        throw std::invalid_argument("Zero has no inverse.");
+    return { *_field, _field->inverted(toBigNum()) };
+}
+
+FieldElement FieldElement::squared() const {
+    return *this * *this;
+}
+
+FieldElement FieldElement::doubled() const {
+    return *this + *this;
+}
+
+FieldElement operator+(const FieldElement& left, const FieldElement& right) {
+    ///both are below modulo, so the sum is below 2 * modulo
+    const BigNum& mod = left._field->modulo();
+    BigNum sum = left._value + right._value;
+    if (sum >= mod)
+        sum -= mod;
+    return { left._field, std::move(sum) };
+}
+
+FieldElement operator-(const FieldElement& left, const FieldElement& right) {
+    BigNum difference = left._value;
+    if (difference < right._value)
+        difference += left._field->modulo();
+    difference -= right._value;
+    return { left._field, std::move(difference) };
+}
+
+FieldElement operator-(const FieldElement& element) {
+    if (element.isZero())
+        return element;
+    return { element._field, element._field->modulo() - element._value };
+}
+
+FieldElement operator*(const FieldElement& left, const FieldElement& right) {
+    const auto& montgomery = left._field->montgomery();
+    if (montgomery)
+        return { left._field, montgomery->multiply(left._value, right._value) };
+    return { left._field, left._field->multiply(left._value, right._value) };
+}
+
+FieldElement& FieldElement::operator+=(const FieldElement& that) {
+    return *this = *this + that;
+}
+
+FieldElement& FieldElement::operator-=(const FieldElement& that) {
+    return *this = *this - that;
+}
+
+FieldElement& FieldElement::operator*=(const FieldElement& that) {
+    return *this = *this * that;
+}
+
+std::vector<FieldElement> invertedBatch(const std::vector<FieldElement>& elements) {
+    if (elements.empty())
+        return {};
+
+    ///prefix[i] = elements[0] * ... * elements[i]
+    std::vector<FieldElement> prefix;
+    prefix.reserve(elements.size());
+    for (const auto& element : elements) {
+        if (element.isZero())
+            throw std::invalid_argument("Zero has no inverse.");
+        prefix.push_back(prefix.empty() ? element : prefix.back() * element);
+    }
+
+    std::vector<FieldElement> result(elements.size());
+    FieldElement inverse = prefix.back().inverted();
+    for (int i = elements.size() - 1; i > 0; --i) {
+        result[i] = inverse * prefix[i - 1];
+        inverse *= elements[i];
+    }
+    result[0] = inverse;
+    return result;
+}
+
+} // namespace lab
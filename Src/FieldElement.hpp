@@ -0,0 +1,199 @@
+#pragma once
+
+#include "BigNum.hpp"
+#include "Field.hpp"
+
+#include <vector>
+
+namespace lab {
+
+template<int Bound>
+class LazyElement;
+
+/**
+ * @brief Element of field kept reduced and, if field has Montgomery constants, in Montgomery form,
+ *        so multiplication never divides and addition needs one subtraction at most.
+ *        Plain BigNum is seen only in constructor and toBigNum()
+ * @note Element keeps raw pointer to its field, the owner of the element keeps the field alive
+ *       (EllipticCurve does it through its std::shared_ptr<const Field>).
+ *       Both operands of binary operators must belong to the same field, it is not checked
+ */
+class FieldElement {
+public:
+    /**
+     * @brief Element bound to no field, only to be assigned
+     */
+    FieldElement() = default;
+
+    /**
+     * @param num any non negative number, reduced modulo field modulo
+     */
+    FieldElement(const Field& field, const BigNum& num);
+
+    static FieldElement zero(const Field& field);
+
+    static FieldElement one(const Field& field);
+
+    const Field& getField() const;
+
+    /**
+     * @return Plain value in [0, modulo)
+     */
+    BigNum toBigNum() const;
+
+    bool isZero() const;
+
+    /**
+     * @throws std::invalid_argument if element is zero
+     */
+    FieldElement inverted() const;
+
+    FieldElement squared() const;
+
+    /**
+     * @return 2 * element by one addition
+     */
+    FieldElement doubled() const;
+
+    /**
+     * @brief Starts unreduced sum, see LazyElement
+     */
+    LazyElement<1> lazy() const;
+
+    friend bool operator==(const FieldElement& left, const FieldElement& right) {
+        return left._value == right._value;
+    }
+
+    friend bool operator!=(const FieldElement& left, const FieldElement& right) {
+        return !(left == right);
+    }
+
+    friend FieldElement operator+(const FieldElement& left, const FieldElement& right);
+    friend FieldElement operator-(const FieldElement& left, const FieldElement& right);
+    friend FieldElement operator-(const FieldElement& element);
+    friend FieldElement operator*(const FieldElement& left, const FieldElement& right);
+
+    FieldElement& operator+=(const FieldElement& that);
+    FieldElement& operator-=(const FieldElement& that);
+    FieldElement& operator*=(const FieldElement& that);
+
+private:
+    template<int Bound>
+    friend class LazyElement;
+
+    FieldElement(const Field* field, BigNum value) : _field(field), _value(std::move(value)) {}
+
+    const Field* _field = nullptr;
+    /// num * R % modulo in Montgomery form, num itself without Montgomery constants
+    BigNum _value;
+};
+
+/**
+ * @brief Unreduced sum of field elements below Bound * modulo. Bound is part of the type, so
+ *        additions skip conditional subtractions and reduced() takes one compare and subtract
+ *        per bit of Bound instead of one per addition. Multiplication needs reduced operands.
+ *        Values in Montgomery form are summed as is: (a + b) * R = a * R + b * R
+ */
+template<int Bound>
+class LazyElement {
+    static_assert(Bound >= 1 && Bound <= (1 << Field::MAX_LAZY_BITS), "Lazy sum exceeds headroom of Field.");
+
+public:
+    template<int Other>
+    LazyElement<Bound + Other> operator+(const LazyElement<Other>& that) const& {
+        return LazyElement(*this) + that;
+    }
+
+    template<int Other>
+    LazyElement<Bound + Other> operator+(const LazyElement<Other>& that) && {
+        _value += that._value;
+        return { _field, std::move(_value) };
+    }
+
+    LazyElement<Bound + 1> operator+(const FieldElement& that) const& {
+        return LazyElement(*this) + that;
+    }
+
+    LazyElement<Bound + 1> operator+(const FieldElement& that) && {
+        _value += that._value;
+        return { _field, std::move(_value) };
+    }
+
+    /**
+     * @brief Bound holds: value >= that gives value - that, otherwise value < that < modulo
+     *        and value + modulo - that < modulo
+     */
+    LazyElement operator-(const FieldElement& that) const& {
+        return LazyElement(*this) - that;
+    }
+
+    LazyElement operator-(const FieldElement& that) && {
+        if (_value < that._value)
+            _value += _field->modulo();
+        _value -= that._value;
+        return std::move(*this);
+    }
+
+    LazyElement<2 * Bound> doubled() const& {
+        return LazyElement(*this).doubled();
+    }
+
+    LazyElement<2 * Bound> doubled() && {
+        _value += _value;
+        return { _field, std::move(_value) };
+    }
+
+    /**
+     * @brief Subtracts modulo * 2^i for every bit i of Bound - 1 from the highest
+     */
+    FieldElement reduced() const& {
+        return LazyElement(*this).reduced();
+    }
+
+    FieldElement reduced() && {
+        for (int power = _steps() - 1; power >= 0; --power) {
+            const BigNum& multiple = _field->moduloMultiple(power);
+            if (_value >= multiple)
+                _value -= multiple;
+        }
+        return { _field, std::move(_value) };
+    }
+
+private:
+    template<int Other>
+    friend class LazyElement;
+    friend class FieldElement;
+
+    LazyElement(const Field* field, BigNum value) : _field(field), _value(std::move(value)) {}
+
+    /**
+     * @return Least k with Bound <= 2^k
+     */
+    static constexpr int _steps() {
+        int steps = 0;
+        while ((1 << steps) < Bound)
+            ++steps;
+        return steps;
+    }
+
+    const Field* _field;
+    BigNum _value;
+};
+
+inline LazyElement<1> FieldElement::lazy() const {
+    return { _field, _value };
+}
+
+/**
+ * @brief Inverts all elements with one inversion (Montgomery's trick)
+ * @throws std::invalid_argument if any element is zero
+ */
+std::vector<FieldElement> invertedBatch(const std::vector<FieldElement>& elements);
+
+template<typename OStream>
+OStream& operator<<(OStream& os, const FieldElement& element) {
+    os << element.toBigNum();
+    return os;
+}
+
+} // namespace lab
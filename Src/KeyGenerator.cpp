@@ -3,14 +3,36 @@
 namespace lab{
 
 Client::Client(const EllipticCurve& curve, const BigNum& pow, const Point& point)
-                : _curve(curve), _pow(pow), _point(point), _private_key(Point(0_bn, 0_bn)) {}
+                : _curve(curve), _pow(pow), _point(point) {}
+
+Client::Client(const EllipticCurve& curve, const BigNum& pow, std::shared_ptr<const FixedBaseTable> generator_table)
+                : _curve(curve), _pow(pow), _point(generator_table->getGenerator()),
+                  _generator_table(std::move(generator_table)) {
+    if (_generator_table->getCurve() != curve)
+        throw std::invalid_argument("Generator table is built for another curve.");
+}
+
+Client::Client(const MontgomeryCurve& curve, const BigNum& pow, const BigNum& u)
+                : _pow(pow), _point(EllipticCurve::neutral), _montgomery(curve), _u(u) {}
+
+bool Client::isXOnly() const {
+    return _montgomery.has_value();
+}
 
 Point Client::getPrivateKey() const{
-    return _private_key;
+    if (_montgomery)
+        throw std::logic_error("x-only client has u-coordinates only.");
+    if (!_private_key)
+        throw std::logic_error("Private key is not set, no public key of the other client was given.");
+    return *_private_key;
 }
 
 Point Client::getPublicKey() const{
-    return _curve.powerPoint(_point, _pow);
+    if (_montgomery)
+        throw std::logic_error("x-only client has u-coordinates only.");
+    if (_generator_table)
+        return _generator_table->multiplyGenerator(_pow);
+    return _curve.powerPointSecret(_point, _pow);
 }
 
 Point Client::getPoint() const{
@@ -22,12 +44,43 @@ EllipticCurve Client::getCurve() const{
 }
 
 void Client::setPrivateKey(const Point& gotPublicKey) {
-    try{
-        _private_key = _curve.powerPoint(gotPublicKey, _pow);
-    }
-    catch(std::exception& e){
-        std::cout << _pow << std::endl;
+    _private_key = _curve.powerPointSecret(gotPublicKey, _pow);
+}
+
+std::vector<uint8_t> Client::getEncodedPublicKey() const {
+    if (_montgomery)
+        return _montgomery->encodeU(_montgomery->ladder(_u, _pow));
+    return _curve.encodePoint(getPublicKey());
+}
+
+std::vector<uint8_t> Client::getEncodedPrivateKey() const {
+    if (_montgomery ? !_private_key_u : !_private_key)
+        throw std::logic_error("Private key is not set, no public key of the other client was given.");
+
+    ///low order public key of the other side gives no shared secret (RFC 7748, section 6.1)
+    if (_montgomery) {
+        if (*_private_key_u == 0_bn)
+            throw std::invalid_argument("Shared u-coordinate is zero, public key has low order.");
+        return _montgomery->encodeU(*_private_key_u);
     }
+    if (*_private_key == EllipticCurve::neutral)
+        throw std::invalid_argument("Shared point is neutral, public key has low order.");
+    return toBytes(_private_key->x, _curve.getField()->byteLength());
+}
+
+void Client::setPrivateKey(const std::vector<uint8_t>& gotPublicKey) {
+    if (_montgomery)
+        _private_key_u = _montgomery->ladder(_montgomery->decodeU(gotPublicKey), _pow);
+    else if (_key_cache)
+        setPrivateKey(_key_cache->validate(gotPublicKey));
+    else
+        setPrivateKey(_curve.decodePoint(gotPublicKey));
+}
+
+void Client::setKeyCache(std::shared_ptr<const PublicKeyCache> key_cache) {
+    if (key_cache && key_cache->getCurve() != _curve)
+        throw std::invalid_argument("Key cache is built for another curve.");
+    _key_cache = std::move(key_cache);
 }
 
 GettingKeySimulation::GettingKeySimulation(const EllipticCurve& curve, const BigNum& xPow, const BigNum& yPow, const Point& point)
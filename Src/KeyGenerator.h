@@ -1,8 +1,12 @@
 #pragma once
 
 #include "EllipticCurves.hpp"
+#include "CurveModels.hpp"
 #include "BigNum.hpp"
 
+#include <memory>
+#include <optional>
+
 namespace  lab {
 class Client {
 public:
@@ -10,24 +14,80 @@ public:
 
     Client(const EllipticCurve& curve, const BigNum& pow, const Point& point);
 
+    /**
+     * @brief Client computing public key from precomputed table of generator multiples
+     * @note Table lookups depend on the key, so this trades SecretScalarMode::Ladder guarantees for speed
+     * @throws std::invalid_argument if the table is built for another curve
+     */
+    Client(const EllipticCurve& curve, const BigNum& pow, std::shared_ptr<const FixedBaseTable> generator_table);
+
+    /**
+     * @brief x-only client (X25519 style): keys are u-coordinates computed by MontgomeryCurve::ladder,
+     *        so there is no y and no inversion per step, and encoded keys take bytes of modulo only
+     * @param u u-coordinate of the base point
+     */
+    Client(const MontgomeryCurve& curve, const BigNum& pow, const BigNum& u);
+
+    bool isXOnly() const;
+
+    /**
+     * @throws std::logic_error for x-only client, use getEncodedPublicKey
+     */
     Point getPublicKey() const;
 
+    /**
+     * @throws std::logic_error for x-only client, use getEncodedPrivateKey, or before setPrivateKey
+     */
     Point getPrivateKey() const;
 
+    /**
+     * @return Little-endian u for x-only client (MontgomeryCurve::encodeU), compressed SEC1 point otherwise
+     */
+    std::vector<uint8_t> getEncodedPublicKey() const;
+
+    /**
+     * @return Little-endian u for x-only client, big-endian x of the shared point otherwise
+     * @throws std::logic_error before setPrivateKey
+     * @throws std::invalid_argument if shared u is zero or shared point is neutral,
+     *         which happens for low order public key of the other client
+     */
+    std::vector<uint8_t> getEncodedPrivateKey() const;
+
     Point getPoint() const;
 
     EllipticCurve getCurve() const;
 
     /**
      * @brief sets private key, gets as parametr public key generated by second client
+     * @note Exceptions of EllipticCurve::powerPointSecret propagate and the previous private key is kept
      */
     void setPrivateKey(const Point& gotPublicKey);
 
+    /**
+     * @brief sets private key from public key encoded by getEncodedPublicKey of second client,
+     *        validated through key cache if it is set
+     * @throws std::invalid_argument if the key cache rejects the key
+     */
+    void setPrivateKey(const std::vector<uint8_t>& gotPublicKey);
+
+    /**
+     * @brief Validates encoded public keys of other clients with cache, shared with other clients of the curve
+     * @throws std::invalid_argument if the cache is built for another curve
+     */
+    void setKeyCache(std::shared_ptr<const PublicKeyCache> key_cache);
+
 private:
     EllipticCurve _curve;
     BigNum _pow;
     Point _point;
-    Point _private_key;
+    /// empty until setPrivateKey
+    std::optional<Point> _private_key;
+    std::shared_ptr<const FixedBaseTable> _generator_table;
+    std::shared_ptr<const PublicKeyCache> _key_cache;
+    /// x-only mode: base point and private key are u-coordinates
+    std::optional<MontgomeryCurve> _montgomery;
+    BigNum _u;
+    std::optional<BigNum> _private_key_u;
 };
 
 class GettingKeySimulation{
@@ -0,0 +1,244 @@
+#include <Polynomial.hpp>
+
+#include <stdexcept>
+
+namespace lab {
+
+Polynomial::Polynomial(std::shared_ptr<const Field> field, const std::vector<BigNum>& coefficients)
+    : _field(std::move(field)), _coefficients(coefficients) {
+    for (auto& coefficient : _coefficients)
+        coefficient = _field->reduce(coefficient);
+    _trim();
+}
+
+Polynomial Polynomial::monomial(std::shared_ptr<const Field> field, int degree, const BigNum& coefficient) {
+    std::vector<BigNum> coefficients(degree + 1, 0_bn);
+    coefficients[degree] = coefficient;
+    return Polynomial(field, coefficients);
+}
+
+const std::shared_ptr<const Field>& Polynomial::getField() const {
+    return _field;
+}
+
+int Polynomial::degree() const {
+    return static_cast<int>(_coefficients.size()) - 1;
+}
+
+bool Polynomial::isZero() const {
+    return _coefficients.empty();
+}
+
+BigNum Polynomial::operator[](int i) const {
+    return i < _coefficients.size() ? _coefficients[i] : 0_bn;
+}
+
+const std::vector<BigNum>& Polynomial::coefficients() const {
+    return _coefficients;
+}
+
+const BigNum& Polynomial::leading() const {
+    return _coefficients.back();
+}
+
+Polynomial Polynomial::monic() const {
+    if (isZero())
+        return *this;
+    return *this * _field->inverted(leading());
+}
+
+Polynomial Polynomial::derivative() const {
+    std::vector<BigNum> coefficients;
+    for (int i = 1; i < _coefficients.size(); ++i)
+        coefficients.push_back(_coefficients[i] * i);
+    return Polynomial(_field, coefficients);
+}
+
+BigNum Polynomial::evaluate(const BigNum& x) const {
+    BigNum result = 0_bn;
+    for (auto coefficient = _coefficients.rbegin(); coefficient != _coefficients.rend(); ++coefficient)
+        result = add(_field->multiply(result, x), *coefficient, _field->modulo());
+    return result;
+}
+
+void Polynomial::_trim() {
+    while (!_coefficients.empty() && _coefficients.back() == 0_bn)
+        _coefficients.pop_back();
+}
+
+bool operator==(const Polynomial& left, const Polynomial& right) {
+    return left._coefficients == right._coefficients;
+}
+
+bool operator!=(const Polynomial& left, const Polynomial& right) {
+    return !(left == right);
+}
+
+Polynomial operator+(const Polynomial& left, const Polynomial& right) {
+    const BigNum& mod = left._field->modulo();
+    Polynomial result(left._field);
+    result._coefficients.resize(std::max(left._coefficients.size(), right._coefficients.size()));
+    for (int i = 0; i < result._coefficients.size(); ++i)
+        result._coefficients[i] = add(left[i], right[i], mod);
+    result._trim();
+    return result;
+}
+
+Polynomial operator-(const Polynomial& left, const Polynomial& right) {
+    const BigNum& mod = left._field->modulo();
+    Polynomial result(left._field);
+    result._coefficients.resize(std::max(left._coefficients.size(), right._coefficients.size()));
+    for (int i = 0; i < result._coefficients.size(); ++i)
+        result._coefficients[i] = subtract(left[i], right[i], mod);
+    result._trim();
+    return result;
+}
+
+Polynomial operator*(const Polynomial& left, const Polynomial& right) {
+    if (left.isZero() || right.isZero())
+        return Polynomial(left._field);
+
+    /// slots hold sums of up to min size products of coefficients below modulo
+    const BigNum& mod = left._field->modulo();
+    const auto size = std::min(left._coefficients.size(), right._coefficients.size());
+    const int slot = cellCount((mod - 1_bn) * (mod - 1_bn) * BigNum(std::to_string(size)));
+
+    Polynomial result(left._field);
+    result._coefficients = unpack(pack(left._coefficients, slot) * pack(right._coefficients, slot), slot,
+                                  left._coefficients.size() + right._coefficients.size() - 1);
+    for (auto& coefficient : result._coefficients)
+        coefficient = left._field->reduce(coefficient);
+    result._trim();
+    return result;
+}
+
+Polynomial operator*(const Polynomial& poly, const BigNum& scalar) {
+    Polynomial result = poly;
+    for (auto& coefficient : result._coefficients)
+        coefficient = poly._field->multiply(coefficient, scalar);
+    result._trim();
+    return result;
+}
+
+std::pair<Polynomial, Polynomial> divide(const Polynomial& dividend, const Polynomial& divisor) {
+    if (divisor.isZero())
+        throw std::invalid_argument("Division by zero polynomial.");
+    if (dividend.degree() < divisor.degree())
+        return { Polynomial(dividend._field), dividend };
+
+    const BigNum& mod = dividend._field->modulo();
+    const auto& field = dividend._field;
+    const BigNum lead_inverted = field->inverted(divisor.leading());
+    Polynomial quotient(dividend._field);
+    Polynomial remainder = dividend;
+    quotient._coefficients.resize(dividend.degree() - divisor.degree() + 1);
+    for (int i = quotient.degree(); i >= 0; --i) {
+        const BigNum coefficient = field->multiply(remainder._coefficients[i + divisor.degree()], lead_inverted);
+        quotient._coefficients[i] = coefficient;
+        if (coefficient == 0_bn)
+            continue;
+        for (int j = 0; j <= divisor.degree(); ++j)
+            remainder._coefficients[i + j] = subtract(remainder._coefficients[i + j],
+                                                      field->multiply(coefficient, divisor._coefficients[j]), mod);
+    }
+    quotient._trim();
+    remainder._trim();
+    return { quotient, remainder };
+}
+
+Polynomial operator/(const Polynomial& dividend, const Polynomial& divisor) {
+    return divide(dividend, divisor).first;
+}
+
+Polynomial operator%(const Polynomial& dividend, const Polynomial& divisor) {
+    return divide(dividend, divisor).second;
+}
+
+Polynomial gcd(const Polynomial& left, const Polynomial& right) {
+    Polynomial first = left;
+    Polynomial second = right;
+    while (!second.isZero()) {
+        Polynomial remainder = first % second;
+        first = std::move(second);
+        second = std::move(remainder);
+    }
+    return first.monic();
+}
+
+std::pair<Polynomial, Polynomial> extendedGcd(const Polynomial& poly, const Polynomial& mod) {
+    /// s_i * poly = r_i (mod mod) holds for every remainder
+    Polynomial r_prev = mod;
+    Polynomial r = poly % mod;
+    Polynomial s_prev(poly._field);
+    Polynomial s(poly._field, { 1_bn });
+    while (!r.isZero()) {
+        auto [quotient, remainder] = divide(r_prev, r);
+        Polynomial s_next = s_prev - quotient * s;
+        r_prev = std::move(r);
+        r = std::move(remainder);
+        s_prev = std::move(s);
+        s = std::move(s_next);
+    }
+
+    const BigNum lead_inverted = poly._field->inverted(r_prev.leading());
+    return { r_prev * lead_inverted, s_prev * lead_inverted % mod };
+}
+
+PolynomialModulus::PolynomialModulus(const Polynomial& modulus)
+    : _modulus(modulus.monic()), _reversed_inverse(modulus.getField()) {
+    if (_modulus.degree() < 1)
+        throw std::invalid_argument("Modulus polynomial must not be constant.");
+
+    /// series inversion: reversed modulus starts with 1, every next coefficient cancels the sum below it
+    const BigNum& mod = _modulus.getField()->modulo();
+    const int degree = _modulus.degree();
+    std::vector<BigNum> inverse(std::max(degree - 1, 1), 0_bn);
+    inverse[0] = 1_bn;
+    for (int k = 1; k < inverse.size(); ++k) {
+        BigNum sum = 0_bn;
+        for (int j = 1; j <= k; ++j)
+            sum = sum + _modulus[degree - j] * inverse[k - j];
+        inverse[k] = subtract(0_bn, _modulus.getField()->reduce(sum), mod);
+    }
+    _reversed_inverse = Polynomial(modulus.getField(), inverse);
+}
+
+const Polynomial& PolynomialModulus::modulo() const {
+    return _modulus;
+}
+
+Polynomial PolynomialModulus::reduce(const Polynomial& poly) const {
+    const int degree = _modulus.degree();
+    if (poly.degree() < degree)
+        return poly;
+    if (poly.degree() > 2 * degree - 2)
+        return poly % _modulus;
+
+    /// reversed quotient is reversed(poly) / reversed(modulus) modulo x^(deg poly - d + 1)
+    const int quotient_size = poly.degree() - degree + 1;
+    const auto& coefficients = poly.coefficients();
+    const Polynomial reversed(poly.getField(), { coefficients.rbegin(), coefficients.rbegin() + quotient_size });
+    auto quotient_reversed = (reversed * _reversed_inverse).coefficients();
+    quotient_reversed.resize(quotient_size, 0_bn);
+    const Polynomial quotient(poly.getField(), { quotient_reversed.rbegin(), quotient_reversed.rend() });
+
+    return poly - quotient * _modulus;
+}
+
+Polynomial PolynomialModulus::multiply(const Polynomial& left, const Polynomial& right) const {
+    return reduce(left * right);
+}
+
+Polynomial PolynomialModulus::pow(const Polynomial& base, const BigNum& degree) const {
+    Polynomial result = reduce(Polynomial(base.getField(), { 1_bn }));
+    const Polynomial reduced_base = reduce(base);
+    const auto bits = toBinary(degree);
+    for (auto bit = bits.rbegin(); bit != bits.rend(); ++bit) {
+        result = multiply(result, result);
+        if (*bit == 1)
+            result = multiply(result, reduced_base);
+    }
+    return result;
+}
+
+} // namespace lab
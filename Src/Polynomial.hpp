@@ -0,0 +1,152 @@
+#pragma once
+
+#include "BigNum.hpp"
+#include "Field.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace lab {
+
+/**
+ * @brief Polynomial with coefficients in field, coefficients are kept reduced
+ *        and without leading zeros, so zero polynomial has none
+ */
+class Polynomial {
+public:
+    /**
+     * @param coefficients the lowest degree first, reduced modulo field modulo
+     */
+    Polynomial(std::shared_ptr<const Field> field, const std::vector<BigNum>& coefficients = {});
+
+    /**
+     * @return coefficient * x^degree
+     */
+    static Polynomial monomial(std::shared_ptr<const Field> field, int degree, const BigNum& coefficient = 1_bn);
+
+    const std::shared_ptr<const Field>& getField() const;
+
+    /**
+     * @return Degree of polynomial, -1 for zero
+     */
+    int degree() const;
+
+    bool isZero() const;
+
+    /**
+     * @return Coefficient of x^i, zero above degree
+     */
+    BigNum operator[](int i) const;
+
+    const std::vector<BigNum>& coefficients() const;
+
+    /**
+     * @brief Leading coefficient, polynomial must be non zero
+     */
+    const BigNum& leading() const;
+
+    /**
+     * @brief Polynomial divided by its leading coefficient, zero stays zero
+     */
+    Polynomial monic() const;
+
+    Polynomial derivative() const;
+
+    /**
+     * @brief Value at point x by Horner's scheme
+     */
+    BigNum evaluate(const BigNum& x) const;
+
+    friend bool operator==(const Polynomial& left, const Polynomial& right);
+    friend bool operator!=(const Polynomial& left, const Polynomial& right);
+
+    friend Polynomial operator+(const Polynomial& left, const Polynomial& right);
+    friend Polynomial operator-(const Polynomial& left, const Polynomial& right);
+
+    /**
+     * @brief Kronecker substitution: coefficients are packed into one BigNum each, so product
+     *        of polynomials is a single Karatsuba product of numbers
+     */
+    friend Polynomial operator*(const Polynomial& left, const Polynomial& right);
+    friend Polynomial operator*(const Polynomial& poly, const BigNum& scalar);
+
+    /**
+     * @return Quotient and remainder
+     * @throws std::invalid_argument if divisor is zero
+     */
+    friend std::pair<Polynomial, Polynomial> divide(const Polynomial& dividend, const Polynomial& divisor);
+    friend Polynomial operator/(const Polynomial& dividend, const Polynomial& divisor);
+    friend Polynomial operator%(const Polynomial& dividend, const Polynomial& divisor);
+
+    /**
+     * @return Monic greatest common divisor, zero for two zeros
+     */
+    friend Polynomial gcd(const Polynomial& left, const Polynomial& right);
+
+    /**
+     * @return Monic gcd g of poly and mod with s such that s * poly = g (mod mod),
+     *         s is inverse of poly modulo mod iff g = 1
+     */
+    friend std::pair<Polynomial, Polynomial> extendedGcd(const Polynomial& poly, const Polynomial& mod);
+
+    template<typename OStream>
+    friend OStream& operator<<(OStream& os, const Polynomial& poly);
+
+private:
+    void _trim();
+
+    std::shared_ptr<const Field> _field;
+    /// coefficients, the lowest degree first
+    std::vector<BigNum> _coefficients;
+};
+
+template<typename OStream>
+OStream& operator<<(OStream& os, const Polynomial& poly) {
+    if (poly.isZero()) {
+        os << "0";
+        return os;
+    }
+    bool first = true;
+    for (int i = poly.degree(); i >= 0; --i) {
+        if (poly._coefficients[i] == 0_bn)
+            continue;
+        if (!first)
+            os << " + ";
+        first = false;
+        if (i == 0 || poly._coefficients[i] != 1_bn)
+            os << poly._coefficients[i] << (i > 0 ? "*" : "");
+        if (i > 0)
+            os << "x" << (i > 1 ? "^" + std::to_string(i) : "");
+    }
+    return os;
+}
+
+/**
+ * @brief Arithmetic modulo fixed polynomial: inverse of the reversed modulus is calculated
+ *        once, so every reduction takes two products instead of long division (Barrett)
+ */
+class PolynomialModulus {
+public:
+    /**
+     * @throws std::invalid_argument if modulus is constant
+     */
+    explicit PolynomialModulus(const Polynomial& modulus);
+
+    /**
+     * @brief Monic modulus, it generates the same ideal as the given one
+     */
+    const Polynomial& modulo() const;
+
+    Polynomial reduce(const Polynomial& poly) const;
+
+    Polynomial multiply(const Polynomial& left, const Polynomial& right) const;
+
+    Polynomial pow(const Polynomial& base, const BigNum& degree) const;
+
+private:
+    Polynomial _modulus;
+    /// 1 / reversed(modulus) as power series modulo x^(deg modulus - 1)
+    Polynomial _reversed_inverse;
+};
+
+} // namespace lab
@@ -0,0 +1,147 @@
+#include <PredefineEllipticCurves.hpp>
+
+#include <stdexcept>
+#include <unordered_map>
+
+namespace lab {
+
+namespace {
+/**
+ * @brief Parameters of standard curve as decimal strings
+ */
+struct CurveParameters {
+    const char* name;
+    const char* modulo;
+    const char* a;
+    const char* b;
+    const char* generator_x;
+    const char* generator_y;
+    const char* order;
+    const char* cofactor;
+};
+
+const CurveParameters STANDARD_CURVES[] = {
+    /// SEC 2, y^2 = x^3 + 7
+    { "secp256k1",
+      "115792089237316195423570985008687907853269984665640564039457584007908834671663",
+      "0",
+      "7",
+      "55066263022277343669578718895168534326250603453777594175500187360389116729240",
+      "32670510020758816978083085130507043184471273380659243275938904335757337482424",
+      "115792089237316195423570985008687907852837564279074904382605163141518161494337",
+      "1" },
+    /// FIPS 186-4, A = -3
+    { "P-256",
+      "115792089210356248762697446949407573530086143415290314195533631308867097853951",
+      "115792089210356248762697446949407573530086143415290314195533631308867097853948",
+      "41058363725152142129326129780047268409114441015993725554835256314039467401291",
+      "48439561293906451759052585252797914202762949526041747995844080717082404635286",
+      "36134250956749795798585127919587881956611106672985015071877198253568414405109",
+      "115792089210356248762697446949407573529996955224135760342422259061068512044369",
+      "1" },
+    /// FIPS 186-4, A = -3
+    { "P-384",
+      "39402006196394479212279040100143613805079739270465446667948293404245721771496870329047266088258938001861606973112319",
+      "39402006196394479212279040100143613805079739270465446667948293404245721771496870329047266088258938001861606973112316",
+      "27580193559959705877849011840389048093056905856361568521428707301988689241309860865136260764883745107765439761230575",
+      "26247035095799689268623156744566981891852923491109213387815615900925518854738050089022388053975719786650872476732087",
+      "8325710961489029985546751289520108179287853048861315594709205902480503199884419224438643760392947333078086511627871",
+      "39402006196394479212279040100143613805079739270465446667946905279627659399113263569398956308152294913554433653942643",
+      "1" },
+    /// FIPS 186-4, A = -3, p = 2^521 - 1
+    { "P-521",
+      "6864797660130609714981900799081393217269435300143305409394463459185543183397656052122559640661454554977296311391480858037121987999716643812574028291115057151",
+      "6864797660130609714981900799081393217269435300143305409394463459185543183397656052122559640661454554977296311391480858037121987999716643812574028291115057148",
+      "1093849038073734274511112390766805569936207598951683748994586394495953116150735016013708737573759623248592132296706313309438452531591012912142327488478985984",
+      "2661740802050217063228768716723360960729859168756973147706671368418802944996427808491545080627771902352094241225065558662157113545570916814161637315895999846",
+      "3757180025770020463545507224491183603594455134769762486694567779615544477440556316691234405012945539562144444537289428522585666729196580810124344277578376784",
+      "6864797660130609714981900799081393217269435300143305409394463459185543183397655394245057746333217197532963996371363321113864768612440380340372808892707005449",
+      "1" },
+    /// RFC 7748 Montgomery curve v^2 = u^3 + 486662*u^2 + u moved to x = u + 486662 / 3
+    { "Curve25519",
+      "57896044618658097711785492504343953926634992332820282019728792003956564819949",
+      "19298681539552699237261830834781317975544997444273427339909597334573241639236",
+      "55751746669818908907645289078257140818241103727901012315294400837956729358436",
+      "19298681539552699237261830834781317975544997444273427339909597334652188435546",
+      "14781619447589544791020593568409986887264606134616475288964881837755586237401",
+      "7237005577332262213973186563042994240857116359379907606001950938285454250989",
+      "8" },
+};
+
+/// cube roots of unity giving secp256k1 endomorphism (x, y) -> (beta * x, y) = lambda * (x, y)
+const char* SECP256K1_BETA = "55594575648329892869085402983802832744385952214688224221778511981742606582254";
+const char* SECP256K1_LAMBDA = "37718080363155996902926221483475020450927657555482586988616620542887997980018";
+} // <anonymous> namespace
+
+NamedCurve::NamedCurve(std::string name, const BigNum& modulo, const BigNum& a, const BigNum& b,
+                       const Point& generator, const BigNum& order, const BigNum& cofactor)
+    : _name(std::move(name)), _curve(std::make_shared<const Field>(modulo), a, b),
+      _generator(generator), _order(order), _cofactor(cofactor) {
+    if (_name == "secp256k1")
+        _curve.setEndomorphism({ BigNum(SECP256K1_BETA), BigNum(SECP256K1_LAMBDA), _order, _generator });
+}
+
+const std::string& NamedCurve::getName() const {
+    return _name;
+}
+
+const EllipticCurve& NamedCurve::getCurve() const {
+    return _curve;
+}
+
+const Point& NamedCurve::getGenerator() const {
+    return _generator;
+}
+
+const BigNum& NamedCurve::getOrder() const {
+    return _order;
+}
+
+const BigNum& NamedCurve::getCofactor() const {
+    return _cofactor;
+}
+
+std::shared_ptr<const FixedBaseTable> NamedCurve::getGeneratorTable() const {
+    std::call_once(_generator_table_flag, [this] {
+        _generator_table = std::make_shared<const FixedBaseTable>(_curve, _generator, bitLength(_order));
+    });
+    return _generator_table;
+}
+
+std::shared_ptr<const PublicKeyCache> NamedCurve::getKeyCache() const {
+    std::call_once(_key_cache_flag, [this] {
+        _key_cache = std::make_shared<const PublicKeyCache>(
+            _curve, _cofactor == 1_bn ? std::nullopt : std::optional<BigNum>(_order));
+    });
+    return _key_cache;
+}
+
+std::shared_ptr<const NamedCurve> namedCurve(std::string_view name) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::shared_ptr<const NamedCurve>> constructed;
+
+    const std::lock_guard<std::mutex> lock(mutex);
+    if (const auto it = constructed.find(std::string(name)); it != constructed.end())
+        return it->second;
+
+    for (const auto& parameters : STANDARD_CURVES) {
+        if (name != parameters.name)
+            continue;
+        auto curve = std::make_shared<const NamedCurve>(
+            parameters.name, BigNum(parameters.modulo), BigNum(parameters.a), BigNum(parameters.b),
+            Point(BigNum(parameters.generator_x), BigNum(parameters.generator_y)),
+            BigNum(parameters.order), BigNum(parameters.cofactor));
+        constructed.emplace(parameters.name, curve);
+        return curve;
+    }
+    throw std::invalid_argument("Unknown curve name: " + std::string(name) + ".");
+}
+
+std::vector<std::string> namedCurveNames() {
+    std::vector<std::string> names;
+    for (const auto& parameters : STANDARD_CURVES)
+        names.emplace_back(parameters.name);
+    return names;
+}
+
+} // namespace lab
@@ -2,38 +2,113 @@
 
 #include "EllipticCurves.hpp"
 #include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace lab {
 
 struct FieldMeta {
-    Field field;
+    std::shared_ptr<const Field> field;
     static constexpr int CURVES_PER_FIELED = 3;
     std::array<EllipticCurve, CURVES_PER_FIELED>  curves;
 };
-    
+
+/**
+ * @brief Field shared by all curves of the entry, curves are given by their A and B
+ */
+inline FieldMeta makeFieldMeta(const BigNum& modulo,
+                               const std::array<std::pair<BigNum, BigNum>, FieldMeta::CURVES_PER_FIELED>& coefficients) {
+    FieldMeta meta = { std::make_shared<const Field>(modulo), {} };
+    for (int i = 0; i < FieldMeta::CURVES_PER_FIELED; ++i)
+        meta.curves[i] = EllipticCurve(meta.field, coefficients[i].first, coefficients[i].second);
+    return meta;
+}
+
 /**
 * @brief Elliptic curves database with thier labels on https://www.lmfdb.org/EllipticCurve/Q/
 *        (paste label into a box near the big blue button)
 */
 inline const int FIELD_NUMBER = 3;
 inline const FieldMeta curveDataBase[] = {
-    {Field(234131_bn),
-        {EllipticCurve(new Field(234131_bn),228960_bn,91781_bn), //100016.g1
-         EllipticCurve(new Field(234131_bn),3133_bn,46606_bn), //100040.g1
-         EllipticCurve(new Field(234131_bn),227064_bn,9977_bn) //100040.g4
-        } 
-    }, 
-    {Field(80000005213_bn),
-        {EllipticCurve(new Field(80000005213_bn),39912548_bn,7610314_bn), //100016.h1
-         EllipticCurve(new Field(80000005213_bn),39796616_bn,38003178_bn), //100040.d2
-         EllipticCurve(new Field(80000005213_bn),79966658546_bn,74118524074_bn) //200080.q1
-        } 
-    },
-    {Field(773_bn),
-        {EllipticCurve(new Field(773_bn),761_bn,65_bn), //252.a2
-         EllipticCurve(new Field(773_bn),446_bn,724_bn), //252.a1
-         EllipticCurve(new Field(773_bn),761_bn,20_bn) //216.a1
-        }
-    }
+    makeFieldMeta(234131_bn,
+        {{{228960_bn, 91781_bn}, //100016.g1
+          {3133_bn, 46606_bn},   //100040.g1
+          {227064_bn, 9977_bn}   //100040.g4
+        }}
+    ),
+    makeFieldMeta(80000005213_bn,
+        {{{39912548_bn, 7610314_bn},          //100016.h1
+          {39796616_bn, 38003178_bn},         //100040.d2
+          {79966658546_bn, 74118524074_bn}    //200080.q1
+        }}
+    ),
+    makeFieldMeta(773_bn,
+        {{{761_bn, 65_bn},  //252.a2
+          {446_bn, 724_bn}, //252.a1
+          {761_bn, 20_bn}   //216.a1
+        }}
+    )
+};
+
+/**
+ * @brief Standard curve with base point of prime order, the curve has cofactor * order points.
+ *        Not copyable: it is shared through namedCurve together with its precomputations
+ */
+class NamedCurve {
+public:
+    NamedCurve(std::string name, const BigNum& modulo, const BigNum& a, const BigNum& b,
+               const Point& generator, const BigNum& order, const BigNum& cofactor);
+
+    NamedCurve(const NamedCurve&) = delete;
+    NamedCurve& operator=(const NamedCurve&) = delete;
+
+    const std::string& getName() const;
+
+    const EllipticCurve& getCurve() const;
+
+    const Point& getGenerator() const;
+
+    const BigNum& getOrder() const;
+
+    const BigNum& getCofactor() const;
+
+    /**
+     * @brief Table of generator multiples, built on the first call and shared by all callers
+     */
+    std::shared_ptr<const FixedBaseTable> getGeneratorTable() const;
+
+    /**
+     * @brief Cache of validated peer public keys, built on the first call and shared by all callers.
+     *        Keys are checked to lie in the subgroup of generator if cofactor is not 1
+     */
+    std::shared_ptr<const PublicKeyCache> getKeyCache() const;
+
+private:
+    std::string _name;
+    EllipticCurve _curve;
+    Point _generator;
+    BigNum _order;
+    BigNum _cofactor;
+    mutable std::once_flag _generator_table_flag;
+    mutable std::shared_ptr<const FixedBaseTable> _generator_table;
+    mutable std::once_flag _key_cache_flag;
+    mutable std::shared_ptr<const PublicKeyCache> _key_cache;
 };
+
+/**
+ * @brief Registry of standard curves: secp256k1 (with GLV endomorphism), P-256, P-384, P-521
+ *        and Curve25519 in short Weierstrass form. Curve is constructed on the first request
+ *        and the same immutable object is returned afterwards
+ * @throws std::invalid_argument for unknown name
+ */
+std::shared_ptr<const NamedCurve> namedCurve(std::string_view name);
+
+/**
+ * @return Names accepted by namedCurve
+ */
+std::vector<std::string> namedCurveNames();
+
 } // namespace lab
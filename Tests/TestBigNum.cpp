@@ -64,6 +64,27 @@ TEST_CASE("Big numbers test", "[BigNum]") {
             const BigNum b("12345600077741235700399");
             REQUIRE(add(a, b, mod) == BigNum("210049889585"));
         }
+
+        SECTION( "with carry" ) {
+            REQUIRE(999999999_bn + 1_bn == 1000000000_bn);
+            REQUIRE(1_bn + 999999999999999999_bn == 1000000000000000000_bn);
+            REQUIRE(1000000000000000000000000000_bn - 1_bn == 999999999999999999999999999_bn);
+        }
+
+        SECTION( "in place" ) {
+            BigNum a("999999999999999999");
+            a += 1_bn;
+            REQUIRE(a == 1000000000000000000_bn);
+            a += a;
+            REQUIRE(a == 2000000000000000000_bn);
+            a -= 1999999999999999999_bn;
+            REQUIRE(a == 1_bn);
+            BigNum b = 1_bn;
+            b += 123456789123456789123_bn;
+            REQUIRE(b == 123456789123456789124_bn);
+            b -= b;
+            REQUIRE(b == 0_bn);
+        }
     }
 
     SECTION( "Subtract BigNum" ) {
@@ -264,6 +285,33 @@ TEST_CASE("Big numbers test", "[BigNum]") {
         }
     }
 
+    SECTION( "Cell boundaries" ) {
+        SECTION( "borrow through zero cells" ) {
+            REQUIRE(1000000000000000000000000000000000000000000000_bn - 1_bn == 999999999999999999999999999999999999999999999_bn);
+            REQUIRE(1000000000000000000_bn - 999999999999999999_bn == 1_bn);
+        }
+
+        SECTION( "zero product" ) {
+            REQUIRE(0_bn * 123456789123456789_bn == 0_bn);
+            REQUIRE(123456789123456789_bn * 0_bn == 0_bn);
+            REQUIRE(0_bn * 7 == 0_bn);
+        }
+
+        SECTION( "wide columns" ) {
+            const BigNum nines(std::string(90, '9'));
+            REQUIRE(nines * nines == BigNum(std::string(89, '9') + "8" + std::string(89, '0') + "1"));
+        }
+
+        SECTION( "long quotient" ) {
+            const auto a = 49951059731732816096318595024459455346908302642522308253344685035261931188171010003137838752886587533208381420617177669147303_bn;
+            REQUIRE(extract(a, 1000000000000000000000000000000000001_bn).first == 49951059731732816096318595024459455296957242910789492157026090010802475891213767092348346_bn);
+            REQUIRE(extract(a, 1000000000000000000000000000000000001_bn).second == 595860497522405905529403410576798957_bn);
+            REQUIRE(extract(a, 999999999000000001_bn).first == 49951059781683875828051411070826990589683882161379199825040002698922734062053741366268846057101692224041227_bn);
+            REQUIRE(extract(a, 999999999000000001_bn).second == 587556712445106076_bn);
+            REQUIRE_THROWS_AS(extract(a, 0_bn), std::invalid_argument);
+        }
+    }
+
     SECTION( "Modulo multiplication" ) {
         const auto a = 4241229841928441249124921409124091221_bn;
         const auto b = 12901092091309210942109410951309019490_bn;
@@ -276,11 +324,63 @@ TEST_CASE("Big numbers test", "[BigNum]") {
         REQUIRE(inverted(1442141324241124_bn, 191_bn, BigNum::InversionPolicy::Fermat) == 12_bn);
     }
 
+    SECTION( "Batch inversion" ) {
+        const auto mod = 624334409_bn;
+        const std::vector<BigNum> nums = {2_bn, 1234512345_bn, 624334408_bn, 17_bn};
+        const auto inverses = invertedBatch(nums, mod);
+        REQUIRE(inverses.size() == nums.size());
+        for (int i = 0; i < nums.size(); ++i) {
+            REQUIRE(multiply(nums[i], inverses[i], mod) == 1_bn);
+        }
+        REQUIRE(invertedBatch({}, mod).empty());
+    }
+
     SECTION( "Square root" ) {
         REQUIRE_FALSE(sqrt(2_bn, 4_bn).has_value());
         REQUIRE(sqrt(4_bn, 17_bn).value() == std::pair(2_bn, 15_bn));
         REQUIRE(sqrt(2_bn, 7_bn).value() == std::pair(4_bn, 3_bn));
         REQUIRE(sqrt(10007_bn, 20011_bn) == std::pair(5382_bn, 14629_bn));
+
+        const auto is_root = [](const BigNum& n, const BigNum& p) {
+            const auto roots = sqrt(n, p);
+            return roots && multiply(roots->first, roots->first, p) == n % p
+                         && multiply(roots->second, roots->second, p) == n % p;
+        };
+
+        SECTION("p = 5 (mod 8)") {
+            REQUIRE(is_root(10_bn, 13_bn));
+            REQUIRE(is_root(123456789_bn, 1000000021_bn));
+            REQUIRE_FALSE(sqrt(2_bn, 13_bn).has_value());
+        }
+
+        SECTION("High 2-adic valuation") {
+            /// 3221225473 = 3 * 2^30 + 1, 469762049 = 7 * 2^26 + 1
+            REQUIRE(is_root(1234567_bn * 1234567_bn, 3221225473_bn));
+            REQUIRE(is_root(5_bn, 469762049_bn));
+            REQUIRE(is_root(123456789_bn * 123456789_bn, 469762049_bn));
+        }
+
+        SECTION("Perfect square modulo") {
+            /// Jacobi symbol is never -1 there, so no non-residue can be found
+            REQUIRE_FALSE(sqrt(4_bn, 9_bn).has_value());
+            REQUIRE_FALSE(sqrt(4_bn, 289_bn).has_value());
+            REQUIRE_FALSE(sqrt(7_bn, 16785409_bn).has_value());
+        }
+    }
+
+    SECTION("Jacobi symbol") {
+        REQUIRE(jacobi(1001_bn, 9907_bn) == -1);
+        REQUIRE(jacobi(19_bn, 45_bn) == 1);
+        REQUIRE(jacobi(8_bn, 21_bn) == -1);
+        REQUIRE(jacobi(5_bn, 21_bn) == 1);
+        REQUIRE(jacobi(30_bn, 45_bn) == 0);
+        REQUIRE(jacobi(0_bn, 1_bn) == 1);
+        {
+            const auto p = 115792089237316195423570985008687907853269984665640564039457584007908834671663_bn;
+            const auto a = 98765678909876523456788000000000_bn;
+            REQUIRE(jacobi(a, p) == (powMontgomery(a, (p - 1_bn) / 2_bn, p) == 1_bn ? 1 : -1));
+            REQUIRE(jacobi(a * a, p) == 1);
+        }
     }
 
     SECTION("Calculate Montgomery coefficient") {
@@ -428,6 +528,96 @@ TEST_CASE("Big numbers test", "[BigNum]") {
             const auto mod = 624334409_bn;
             REQUIRE(powMontgomery(base, degree, mod) == 404851936_bn);
         }
+        {
+            /// moduli sharing a factor with NUM_BASE
+            REQUIRE(powMontgomery(3_bn, 4_bn, 25_bn) == 6_bn);
+            REQUIRE(powMontgomery(1234512345_bn, 123123_bn, 6243375_bn) == 91500_bn);
+            REQUIRE(powMontgomery(7_bn, 10_bn, 1000_bn) == 249_bn);
+            REQUIRE(powMontgomery(7_bn, 0_bn, 1_bn) == 0_bn);
+        }
+    }
+
+    SECTION("Fixed base pow") {
+        {
+            const FixedBasePow table(1234512345_bn, 624334409_bn);
+            REQUIRE(table.pow(123123_bn) == 166746373_bn);
+            REQUIRE(table.pow(0_bn) == 1_bn);
+            REQUIRE(table.pow(1_bn) == 1234512345_bn % 624334409_bn);
+        }
+        {
+            const auto mod = 115792089237316195423570985008687907853269984665640564039457584007908834671663_bn;
+            const FixedBasePow table(7_bn, mod, 0, 5);
+            for (const auto& degree : {mod - 2_bn, 2_bn, 98765678909876523456788_bn}) {
+                REQUIRE(table.pow(degree) == powMontgomery(7_bn, degree, mod));
+            }
+        }
+        {
+            /// degree longer than the table falls back to square-and-multiply
+            const FixedBasePow table(3_bn, 6243379_bn, 8);
+            REQUIRE(table.pow(123123_bn) == powMontgomery(3_bn, 123123_bn, 6243379_bn));
+        }
+    }
+
+    SECTION("Multi exponentiation") {
+        const auto mod = 624334409_bn;
+        SECTION("Two bases") {
+            const std::vector<BigNum> bases = {1234512345_bn, 17_bn};
+            const std::vector<BigNum> degrees = {123123_bn, 12312312341234_bn};
+            REQUIRE(multiExp(bases, degrees, mod)
+                    == multiply(powMontgomery(bases[0], degrees[0], mod), powMontgomery(bases[1], degrees[1], mod), mod));
+        }
+
+        SECTION("Many bases") {
+            std::vector<BigNum> bases;
+            std::vector<BigNum> degrees;
+            BigNum expected = 1_bn;
+            for (int i = 1; i <= 20; ++i) {
+                bases.push_back(BigNum(std::to_string(i * 7919)));
+                degrees.push_back(BigNum(std::to_string(i * 104729 + 3)));
+                expected = multiply(expected, powMontgomery(bases.back(), degrees.back(), mod), mod);
+            }
+            REQUIRE(multiExp(bases, degrees, mod) == expected);
+        }
+
+        SECTION("Empty") {
+            REQUIRE(multiExp({}, {}, mod) == 1_bn);
+        }
+    }
+
+    SECTION("Binary representation") {
+        REQUIRE(toBinary(0_bn).empty());
+        REQUIRE(toBinary(6_bn) == std::vector<char>{0, 1, 1});
+        REQUIRE(bitLength(1000000000_bn) == 30);
+    }
+
+    SECTION("Bytes representation") {
+        REQUIRE(toBytes(258_bn, 3) == std::vector<uint8_t>{0x00, 0x01, 0x02});
+        REQUIRE(fromBytes({0x00, 0x01, 0x02}) == 258_bn);
+        REQUIRE(fromBytes(toBytes(98765678909876523456788_bn, 10)) == 98765678909876523456788_bn);
+        REQUIRE_THROWS_AS(toBytes(65536_bn, 2), std::invalid_argument);
+    }
+
+    SECTION("Packing for Kronecker substitution") {
+        const std::vector<BigNum> left = { 3_bn, 0_bn, 1000000007_bn };
+        const std::vector<BigNum> right = { 5_bn, 2_bn };
+        const auto product = unpack(pack(left, 3) * pack(right, 3), 3, 4);
+        REQUIRE(product == std::vector<BigNum>{ 15_bn, 6_bn, 5000000035_bn, 2000000014_bn });
+        REQUIRE_THROWS_AS(pack({ 1000000000_bn }, 1), std::invalid_argument);
+    }
+
+    SECTION("Multiply long numbers") {
+        /// (10^n - 1)^2 = 99..9800..01 takes several levels of Karatsuba
+        const int n = 3000;
+        const BigNum nines(std::string(n, '9'));
+        const BigNum expected(std::string(n - 1, '9') + "8" + std::string(n - 1, '0') + "1");
+        REQUIRE(nines * nines == expected);
+    }
+
+    SECTION("Hash of BigNum") {
+        const std::hash<BigNum> hasher;
+        REQUIRE(hasher(98765678909876523456788_bn) == hasher(BigNum("00098765678909876523456788")));
+        REQUIRE(hasher(1000000000_bn) != hasher(1_bn));
+        REQUIRE(hasher((1000000000_bn * 3_bn) / 1000000000_bn) == hasher(3_bn));
     }
 
     SECTION("Length of BigNum") {
@@ -577,6 +767,29 @@ TEST_CASE("Big numbers test", "[BigNum]") {
         }
     }
 
+    SECTION("Integer roots") {
+        SECTION("isqrt") {
+            REQUIRE(isqrt(0_bn) == 0_bn);
+            REQUIRE(isqrt(99_bn) == 9_bn);
+            REQUIRE(isqrt(100_bn) == 10_bn);
+            REQUIRE(isqrt(348563496834760374863470673046703476037_bn) == 18669855297638500306_bn);
+        }
+
+        SECTION("iroot") {
+            REQUIRE(iroot(80000005213_bn, 4) == 531_bn);
+            REQUIRE(iroot(1000000000000000000000000000_bn, 3) == 1000000000_bn);
+            REQUIRE(iroot(999999999999999999999999999_bn, 3) == 999999999_bn);
+            REQUIRE(iroot(12345_bn, 1) == 12345_bn);
+        }
+
+        SECTION("isPerfectSquare") {
+            REQUIRE(isPerfectSquare(0_bn));
+            REQUIRE(isPerfectSquare(14469003949465881114_bn * 14469003949465881114_bn));
+            REQUIRE_FALSE(isPerfectSquare(14469003949465881114_bn * 14469003949465881114_bn + 1_bn));
+            REQUIRE_FALSE(isPerfectSquare(4095_bn * 4095_bn * 11_bn));
+        }
+    }
+
     SECTION("log of BigNum") {
         SECTION("easy") {
             {
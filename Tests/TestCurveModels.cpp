@@ -0,0 +1,108 @@
+#include <CurveModels.hpp>
+#include <PredefineEllipticCurves.hpp>
+
+#include "catch.hpp"
+
+TEST_CASE("Curve models test", "[curve_models]") {
+    using namespace lab;
+
+    const auto field = std::make_shared<const Field>(
+        57896044618658097711785492504343953926634992332820282019728792003956564819949_bn);
+    const BigNum order("7237005577332262213973186563042994240857116359379907606001950938285454250989");
+    const BigNum k("4878934780275694823645765213679451238234523498234765728354692384756123987");
+
+    SECTION("Invalid curves") {
+        const auto small = std::make_shared<const Field>(1000003_bn);
+        REQUIRE_THROWS_AS(MontgomeryCurve(small, 2_bn, 1_bn), std::invalid_argument);
+        REQUIRE_THROWS_AS(MontgomeryCurve(small, 1000001_bn, 1_bn), std::invalid_argument);
+        REQUIRE_THROWS_AS(MontgomeryCurve(small, 5_bn, 0_bn), std::invalid_argument);
+        REQUIRE_THROWS_AS(EdwardsCurve(small, 0_bn, 5_bn), std::invalid_argument);
+        REQUIRE_THROWS_AS(EdwardsCurve(small, 5_bn, 5_bn), std::invalid_argument);
+    }
+
+    SECTION("Curve25519 in Montgomery form") {
+        const MontgomeryCurve curve(field, 486662_bn, 1_bn);
+        const Point base(9_bn, 14781619447589544791020593568409986887264606134616475288964881837755586237401_bn);
+        REQUIRE(curve.contains(base));
+        REQUIRE_FALSE(curve.contains({ 9_bn, 1_bn }));
+
+        const auto named = namedCurve("Curve25519");
+        REQUIRE(curve.weierstrass() == named->getCurve());
+        REQUIRE(curve.toWeierstrass(base) == named->getGenerator());
+        REQUIRE(curve.fromWeierstrass(named->getGenerator()) == base);
+        REQUIRE(curve.toWeierstrass(EllipticCurve::neutral) == EllipticCurve::neutral);
+
+        const Point doubled = curve.addPoints(base, base);
+        REQUIRE(curve.contains(doubled));
+        REQUIRE(curve.powerPoint(base, 2_bn) == doubled);
+        REQUIRE(curve.powerPoint(base, order) == EllipticCurve::neutral);
+
+        REQUIRE(curve.ladder(9_bn, k) == curve.powerPoint(base, k).x);
+        REQUIRE(curve.ladder(9_bn, 1_bn) == 9_bn);
+        REQUIRE(curve.ladder(9_bn, order) == 0_bn);
+        REQUIRE(curve.ladder(9_bn, 0_bn) == 0_bn);
+    }
+
+    SECTION("Ed25519 in twisted Edwards form") {
+        const EdwardsCurve curve(field, field->modulo() - 1_bn,
+                                 37095705934669439343138083508754565189542113879843219016388785533085940283555_bn);
+        const Point base(15112221349535400772501151409588531511454012693041857206046113283949847762202_bn,
+                         46316835694926478169428394003475163141307993866256225615783033603165251855960_bn);
+        REQUIRE(curve.isComplete());
+        REQUIRE(curve.contains(base));
+        REQUIRE(curve.contains(EdwardsCurve::neutral));
+        REQUIRE_FALSE(curve.contains({ 1_bn, 1_bn }));
+
+        REQUIRE(curve.addPoints(base, EdwardsCurve::neutral) == base);
+        REQUIRE(curve.addPoints(base, curve.invertedPoint(base)) == EdwardsCurve::neutral);
+        REQUIRE(curve.addPoints(base, base) == curve.powerPoint(base, 2_bn));
+        REQUIRE(curve.addPoints(curve.powerPoint(base, 2_bn), base) == curve.powerPoint(base, 3_bn));
+        REQUIRE(curve.powerPoint(base, order) == EdwardsCurve::neutral);
+        REQUIRE(curve.powerPoint(base, 0_bn) == EdwardsCurve::neutral);
+
+        const MontgomeryCurve& montgomery = curve.montgomery();
+        REQUIRE(montgomery.getA() == 486662_bn);
+        const Point mapped = curve.toMontgomery(base);
+        REQUIRE(montgomery.contains(mapped));
+        REQUIRE(curve.fromMontgomery(mapped) == base);
+        REQUIRE(curve.toMontgomery(curve.powerPoint(base, k)) == montgomery.powerPoint(mapped, k));
+        REQUIRE(montgomery.ladder(mapped.x, k) == curve.toMontgomery(curve.powerPoint(base, k)).x);
+
+        REQUIRE(curve.toMontgomery(EdwardsCurve::neutral) == EllipticCurve::neutral);
+        REQUIRE(curve.fromMontgomery(EllipticCurve::neutral) == EdwardsCurve::neutral);
+        const Point two_torsion(0_bn, field->modulo() - 1_bn);
+        REQUIRE(curve.contains(two_torsion));
+        REQUIRE(curve.toMontgomery(two_torsion) == Point(0_bn, 0_bn));
+        REQUIRE(curve.fromMontgomery({ 0_bn, 0_bn }) == two_torsion);
+    }
+
+    SECTION("X25519 test vectors of RFC 7748") {
+        const auto bytes = [](const std::string& hex) {
+            std::vector<uint8_t> result;
+            for (int i = 0; i < hex.size(); i += 2)
+                result.push_back(std::stoi(hex.substr(i, 2), nullptr, 16));
+            return result;
+        };
+
+        REQUIRE(x25519(bytes("a546e36bf0527c9d3b16154b82465edd62144c0ac1fc5a18506a2244ba449ac4"),
+                       bytes("e6db6867583030db3594c1a424b15f7c726624ec26b3353b10a903a6d0ab1c4c"))
+                == bytes("c3da55379de9c6908e94ea4df28d084f32eccf03491c71f754b4075577a28552"));
+        REQUIRE(x25519(bytes("4b66e9d4d1b4673c5ad22691957d6af5c11b6421e0ea01d42ca4169e7918ba0d"),
+                       bytes("e5210f12786811d3f4b7959d0538ae2c31dbe7106fc03c3efc4cd549c715a493"))
+                == bytes("95cbde9476e8907d7aade45cb4b873f88b595a68799fa152e6f8f7647aac7957"));
+
+        const auto base = curve25519().encodeU(9_bn);
+        const auto alice = bytes("77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a");
+        const auto bob = bytes("5dab087e624a8a4b79e17f8b83800ee66f3bb1292618b6fd1c2f8b27ff88e0eb");
+        const auto alice_public = x25519(alice, base);
+        const auto bob_public = x25519(bob, base);
+        REQUIRE(alice_public == bytes("8520f0098930a754748b7ddcb43ef75a0dbf3a0d26381af4eba4a98eaa9b4e6a"));
+        REQUIRE(bob_public == bytes("de9edb7d7b7dc1b4d35b61c2ece435373f8343c85b78674dadfc7e146f882b4f"));
+        REQUIRE(x25519(alice, bob_public) == bytes("4a5d9d5ba4ce2de1728e3bf480350f25e07e21c947d19e3376f09b3c1e161742"));
+        REQUIRE(x25519(bob, alice_public) == x25519(alice, bob_public));
+
+        REQUIRE(curve25519().decodeU(curve25519().encodeU(k % field->modulo())) == k % field->modulo());
+        REQUIRE_THROWS_AS(curve25519().decodeU({ 9 }), std::invalid_argument);
+        REQUIRE_THROWS_AS(x25519({ 1 }, base), std::invalid_argument);
+    }
+}
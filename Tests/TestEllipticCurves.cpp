@@ -103,6 +103,295 @@ TEST_CASE("Elliptic curves test", "[curves]") {
         }
     }
 
+    SECTION("Batch addition") {
+        const auto& curve = curveDataBase[1].curves[0];
+        const lab::Point g = { 2_bn, 66988394260_bn };
+        const lab::Point h = curve.powerPoint(g, 12345_bn);
+
+        const std::vector<lab::Point> first = { g, g, g, EllipticCurve::neutral, h, curve.powerPoint(g, 7_bn) };
+        const std::vector<lab::Point> second = { h, g, curve.invertedPoint(g), h, EllipticCurve::neutral,
+                                                 curve.powerPoint(g, 99_bn) };
+        std::vector<lab::Point> out;
+        curve.addPointsBatch(first, second, out);
+
+        REQUIRE(out.size() == first.size());
+        for (int i = 0; i < first.size(); ++i) {
+            REQUIRE(out[i] == curve.addPoints(first[i], second[i]));
+        }
+    }
+
+    SECTION("Jacobian coordinates") {
+        const auto& curve = curveDataBase[0].curves[2];
+        const lab::Point p1 = { 2570_bn, 130216_bn };
+        const lab::Point p2 = { 110_bn, 574_bn };
+
+        SECTION("Round trip") {
+            REQUIRE(curve.toAffine(curve.toJacobian(p1)) == p1);
+            REQUIRE(curve.toAffine(curve.toJacobian(EllipticCurve::neutral)) == EllipticCurve::neutral);
+        }
+
+        SECTION("Doubling") {
+            REQUIRE(curve.toAffine(curve.doublePoint(curve.toJacobian(p1))) == curve.addPoints(p1, p1));
+            const lab::Point p = { 234117_bn, 0_bn };
+            REQUIRE(curve.toAffine(curve.doublePoint(curve.toJacobian(p))) == EllipticCurve::neutral);
+        }
+
+        SECTION("Addition") {
+            /// z != 1 on both sides
+            const auto j1 = curve.doublePoint(curve.toJacobian(p1));
+            const auto j2 = curve.doublePoint(curve.toJacobian(p2));
+            const auto expected = curve.addPoints(curve.addPoints(p1, p1), curve.addPoints(p2, p2));
+            REQUIRE(curve.toAffine(curve.addPoints(j1, j2)) == expected);
+            REQUIRE(curve.toAffine(curve.addPoints(j1, j1)) == curve.toAffine(curve.doublePoint(j1)));
+            REQUIRE(curve.toAffine(curve.addPoints(j1, curve.toJacobian(curve.invertedPoint(curve.addPoints(p1, p1)))))
+                    == EllipticCurve::neutral);
+        }
+
+        SECTION("Mixed addition") {
+            const auto j1 = curve.doublePoint(curve.toJacobian(p1));
+            REQUIRE(curve.toAffine(curve.addPoints(j1, p2)) == curve.addPoints(curve.addPoints(p1, p1), p2));
+            REQUIRE(curve.toAffine(curve.addPoints(j1, EllipticCurve::neutral)) == curve.addPoints(p1, p1));
+            REQUIRE(curve.toAffine(curve.addPoints(curve.toJacobian(EllipticCurve::neutral), p2)) == p2);
+        }
+
+        SECTION("Batch normalization") {
+            std::vector<JacobianPoint> points = { curve.toJacobian(EllipticCurve::neutral) };
+            for (JacobianPoint p = curve.toJacobian(p1); points.size() < 6; p = curve.doublePoint(p))
+                points.push_back(p);
+            points.push_back(curve.toJacobian(EllipticCurve::neutral));
+
+            const auto affine = curve.normalizeBatch(points);
+            REQUIRE(affine.size() == points.size());
+            for (int i = 0; i < points.size(); ++i) {
+                REQUIRE(affine[i] == curve.toAffine(points[i]));
+            }
+            REQUIRE(curve.normalizeBatch({}).empty());
+        }
+
+        SECTION("Power matches repeated addition") {
+            lab::Point expected = EllipticCurve::neutral;
+            for (int i = 0; i < 100; ++i) {
+                expected = curve.addPoints(expected, p1);
+            }
+            REQUIRE(curve.powerPoint(p1, 100_bn) == expected);
+        }
+    }
+
+    SECTION("Curve shapes") {
+        const auto field = std::make_shared<const Field>(1000003_bn);
+
+        SECTION("Generic") {
+            REQUIRE(curveDataBase[0].curves[0].getShape() == EllipticCurve::Shape::Generic);
+        }
+
+        SECTION("A = 0") {
+            const EllipticCurve curve(field, 0_bn, 7_bn);
+            const lab::Point p = { 2_bn, 579196_bn };
+            REQUIRE(curve.getShape() == EllipticCurve::Shape::AZero);
+            REQUIRE(curve.addPoints(p, p) == lab::Point(199999_bn, 174846_bn));
+            REQUIRE(curve.toAffine(curve.doublePoint(curve.doublePoint(curve.toJacobian(p))))
+                    == curve.addPoints(curve.addPoints(p, p), curve.addPoints(p, p)));
+            REQUIRE(curve.powerPoint(p, 12345_bn) == lab::Point(664879_bn, 353502_bn));
+
+            /// scalars of every NAF width
+            REQUIRE(curve.powerPoint(p, 7_bn) == lab::Point(937358_bn, 266696_bn));
+            REQUIRE(curve.powerPoint(p, 98765678909876523456788_bn) == lab::Point(421337_bn, 687525_bn));
+            REQUIRE(curve.powerPoint(p, 369988485035126972924700782451696644186473100389722973815184405301748249_bn)
+                    == lab::Point(281650_bn, 173837_bn));
+            REQUIRE(curve.powerPoint(p, 57896044618658097711785492504343953926634992332832627698630026571846688276757_bn)
+                    == lab::Point(621007_bn, 127695_bn));
+        }
+
+        SECTION("A = -3") {
+            const EllipticCurve curve(field, 1000000_bn, 5_bn);
+            const lab::Point p = { 5_bn, 361467_bn };
+            REQUIRE(curve.getShape() == EllipticCurve::Shape::AMinusThree);
+            REQUIRE(curve.addPoints(p, p) == lab::Point(547829_bn, 913885_bn));
+            REQUIRE(curve.toAffine(curve.doublePoint(curve.doublePoint(curve.toJacobian(p))))
+                    == curve.addPoints(curve.addPoints(p, p), curve.addPoints(p, p)));
+            REQUIRE(curve.powerPoint(p, 12345_bn) == lab::Point(472087_bn, 177987_bn));
+        }
+    }
+
+    SECTION("Montgomery ladder") {
+        SECTION("Matches NAF multiplication") {
+            const auto& curve = curveDataBase[0].curves[2];
+            const lab::Point p = { 2570_bn, 130216_bn };
+            for (const auto& k : {0_bn, 1_bn, 2_bn, 3_bn, 100_bn, 98765678909876523456788_bn}) {
+                REQUIRE(curve.powerPointLadder(p, k) == curve.powerPoint(p, k));
+            }
+        }
+
+        SECTION("Multiples of order") {
+            const auto& curve = curveDataBase[2].curves[0];
+            const lab::Point p = { 769_bn, 7_bn };
+            REQUIRE(curve.powerPointLadder(p, 383_bn) == EllipticCurve::neutral);
+            REQUIRE(curve.powerPointLadder(p, 382_bn) == curve.invertedPoint(p));
+            REQUIRE(curve.powerPointLadder(p, 384_bn) == p);
+        }
+
+        SECTION("Point with x = 0") {
+            const auto field = std::make_shared<const Field>(1000003_bn);
+            const EllipticCurve curve(field, 0_bn, 4_bn);
+            const lab::Point p = { 0_bn, 2_bn };
+            for (const auto& k : {1_bn, 2_bn, 3_bn, 12345_bn}) {
+                REQUIRE(curve.powerPointLadder(p, k) == curve.powerPoint(p, k));
+            }
+        }
+
+        SECTION("Secret scalar mode") {
+            auto curve = curveDataBase[0].curves[2];
+            const lab::Point p = { 2570_bn, 130216_bn };
+            REQUIRE(curve.getSecretScalarMode() == EllipticCurve::SecretScalarMode::Ladder);
+            curve.setSecretScalarMode(EllipticCurve::SecretScalarMode::WindowedNaf);
+            REQUIRE(curve.getSecretScalarMode() == EllipticCurve::SecretScalarMode::WindowedNaf);
+            REQUIRE(curve.powerPointSecret(p, 12345_bn) == curve.powerPoint(p, 12345_bn));
+        }
+    }
+
+    SECTION("Fixed base table") {
+        const auto& curve = curveDataBase[1].curves[0];
+        const lab::Point g = { 2_bn, 66988394260_bn };
+
+        SECTION("Default window") {
+            const FixedBaseTable table(curve, g);
+            for (const auto& k : {0_bn, 1_bn, 15_bn, 16_bn, 12345_bn, 80000005212_bn}) {
+                REQUIRE(table.multiplyGenerator(k) == curve.powerPoint(g, k));
+            }
+        }
+
+        SECTION("Small window") {
+            const FixedBaseTable table(curve, g, 0, 1);
+            REQUIRE(table.multiplyGenerator(80000005212_bn) == curve.powerPoint(g, 80000005212_bn));
+        }
+
+        SECTION("Scalar longer than table") {
+            const FixedBaseTable table(curve, g, 8);
+            REQUIRE(table.multiplyGenerator(98765678909876523456788_bn) == curve.powerPoint(g, 98765678909876523456788_bn));
+        }
+    }
+
+    SECTION("Multi-scalar multiplication") {
+        const auto& curve = curveDataBase[1].curves[0];
+        const lab::Point g = { 2_bn, 66988394260_bn };
+
+        const auto check = [&](int count) {
+            std::vector<lab::Point> points;
+            std::vector<BigNum> scalars;
+            lab::Point expected = EllipticCurve::neutral;
+            for (int i = 1; i <= count; ++i) {
+                points.push_back(curve.powerPoint(g, BigNum(std::to_string(i * 7919))));
+                scalars.push_back(BigNum(std::to_string(i * 104729 + 3)) * 1000000007);
+                expected = curve.addPoints(expected, curve.powerPoint(points.back(), scalars.back()));
+            }
+            return curve.multiScalarMul(points, scalars) == expected;
+        };
+
+        REQUIRE(curve.multiScalarMul({}, {}) == EllipticCurve::neutral);
+        REQUIRE(check(1));
+        REQUIRE(check(2));
+        REQUIRE(check(5));
+        REQUIRE(check(20));
+
+        SECTION("Shamir's trick with opposite points") {
+            REQUIRE(curve.multiScalarMul({g, curve.invertedPoint(g)}, {12345_bn, 12345_bn}) == EllipticCurve::neutral);
+            REQUIRE(curve.multiScalarMul({g, g}, {3_bn, 0_bn}) == curve.powerPoint(g, 3_bn));
+        }
+    }
+
+    SECTION("Point encoding") {
+        const auto& curve = curveDataBase[1].curves[0];
+        const lab::Point g = { 2_bn, 66988394260_bn };
+
+        SECTION("Compressed") {
+            const auto bytes = curve.encodePoint(g);
+            REQUIRE(bytes == std::vector<uint8_t>{0x02, 0x00, 0x00, 0x00, 0x00, 0x02});
+            REQUIRE(curve.decodePoint(bytes) == g);
+            REQUIRE(curve.decodePoint(curve.encodePoint(curve.invertedPoint(g))) == curve.invertedPoint(g));
+        }
+
+        SECTION("Uncompressed") {
+            const auto bytes = curve.encodePoint(g, false);
+            REQUIRE(bytes.size() == 11);
+            REQUIRE(bytes[0] == 0x04);
+            REQUIRE(curve.decodePoint(bytes) == g);
+        }
+
+        SECTION("Neutral") {
+            REQUIRE(curve.decodePoint(curve.encodePoint(EllipticCurve::neutral)) == EllipticCurve::neutral);
+        }
+
+        SECTION("Invalid") {
+            REQUIRE_THROWS_AS(curve.decodePoint({0x05, 0x00}), std::invalid_argument);
+            REQUIRE_THROWS_AS(curve.decodePoint({0x04, 0, 0, 0, 0, 2, 0, 0, 0, 0, 3}), std::invalid_argument);
+        }
+
+        SECTION("High 2-adic valuation") {
+            /// 3 * 2^30 + 1 takes square roots by Cipolla's algorithm
+            const EllipticCurve high(std::make_shared<const Field>(3221225473_bn), 0_bn, 7_bn);
+            for (const lab::Point& p : { lab::Point(5_bn, 2292392549_bn), lab::Point(5_bn, 928832924_bn) })
+                REQUIRE(high.decodePoint(high.encodePoint(p)) == p);
+        }
+
+        SECTION("Many points") {
+            for (int k = 1; k < 20; ++k) {
+                const auto p = curve.powerPoint(g, BigNum(std::to_string(k * 1000003)));
+                REQUIRE(curve.decodePoint(curve.encodePoint(p)) == p);
+            }
+        }
+    }
+
+    SECTION("GLV endomorphism") {
+        /// secp256k1
+        const auto field = std::make_shared<const Field>(115792089237316195423570985008687907853269984665640564039457584007908834671663_bn);
+        const auto order = 115792089237316195423570985008687907852837564279074904382605163141518161494337_bn;
+        const lab::Point g = { 55066263022277343669578718895168534326250603453777594175500187360389116729240_bn,
+                               32670510020758816978083085130507043184471273380659243275938904335757337482424_bn };
+        const EllipticCurve plain(field, 0_bn, 7_bn);
+        EllipticCurve curve = plain;
+        curve.setEndomorphism({ 55594575648329892869085402983802832744385952214688224221778511981742606582254_bn,
+                                37718080363155996902926221483475020450927657555482586988616620542887997980018_bn,
+                                order, g });
+        REQUIRE(curve.getEndomorphism().has_value());
+
+        const auto k = 98765678909876523456788987656789098765234567889876567890987652345678_bn;
+        const lab::Point expected = { 52634412409063446767786673476677307631107155520966073143567257268642464177588_bn,
+                                      28373216020622001662341490087886169390666940578688295983439108619879570047201_bn };
+        REQUIRE(curve.powerPoint(g, k) == expected);
+        REQUIRE(plain.powerPoint(g, k) == expected);
+        REQUIRE(curve.powerPoint(g, order - 1_bn) == curve.invertedPoint(g));
+        REQUIRE(curve.powerPoint(g, order) == EllipticCurve::neutral);
+        REQUIRE(curve.powerPoint(g, order + 5_bn) == plain.powerPoint(g, 5_bn));
+
+        SECTION("Invalid parameters") {
+            auto copy = plain;
+            REQUIRE_THROWS_AS(copy.setEndomorphism({ 2_bn, 1_bn, order, g }), std::invalid_argument);
+            auto generic = curveDataBase[0].curves[0];
+            REQUIRE_THROWS_AS(generic.setEndomorphism({ 1_bn, 1_bn, order, g }), std::invalid_argument);
+
+            /// beta matches lambda, the other root lambda^2 gives (beta^2 * x, y)
+            const auto beta = 55594575648329892869085402983802832744385952214688224221778511981742606582254_bn;
+            const auto lambda = 37718080363155996902926221483475020450927657555482586988616620542887997980018_bn;
+            const auto other_lambda = multiply(lambda, lambda, order);
+            REQUIRE_THROWS_AS(copy.setEndomorphism({ beta, other_lambda, order, g }), std::invalid_argument);
+            REQUIRE_THROWS_AS(copy.setEndomorphism({ beta, lambda, order, EllipticCurve::neutral }), std::invalid_argument);
+            REQUIRE_THROWS_AS(copy.setEndomorphism({ beta, lambda, order, { g.x, g.y + 1_bn } }), std::invalid_argument);
+            REQUIRE_FALSE(copy.getEndomorphism().has_value());
+
+            /// replacing valid parameters with a wrong pair fails as well
+            REQUIRE_THROWS_AS(curve.setEndomorphism({ beta, other_lambda, order, g }), std::invalid_argument);
+            REQUIRE(curve.getEndomorphism()->lambda == lambda);
+
+            /// #E = 3 * 3391: the pair matches on the subgroup, but points outside of it would get wrong multiples
+            EllipticCurve cofactor_three(std::make_shared<const Field>(10009_bn), 0_bn, 3_bn);
+            const lab::Point p = { 350_bn, 1676_bn };
+            REQUIRE(cofactor_three.powerPoint(p, 3391_bn) == EllipticCurve::neutral);
+            REQUIRE(cofactor_three.powerPoint(p, 2835_bn) == lab::Point(multiply(8964_bn, p.x, 10009_bn), p.y));
+            REQUIRE_THROWS_AS(cofactor_three.setEndomorphism({ 8964_bn, 2835_bn, 3391_bn, p }), std::invalid_argument);
+            REQUIRE_FALSE(cofactor_three.getEndomorphism().has_value());
+        }
+    }
+
     SECTION("Point Order"){
         SECTION("Bortnik"){
             const lab::Point p1 = { 769_bn, 7_bn };
@@ -117,7 +406,105 @@ TEST_CASE("Elliptic curves test", "[curves]") {
             REQUIRE(curveDataBase[2].curves[1].powerPoint(p1, 766_bn) == EllipticCurve::neutral);
             REQUIRE(curveDataBase[2].curves[1].pointOrder(p1) == 766_bn);
         }
+
+        SECTION("Memory budget"){
+            const lab::Point p1 = { 769_bn, 7_bn };
+            REQUIRE(curveDataBase[2].curves[0].pointOrder(p1, 2) == 383_bn);
+
+            const auto& curve = curveDataBase[1].curves[0];
+            const lab::Point g = { 2_bn, 66988394260_bn };
+            const BigNum order = curve.pointOrder(g);
+            REQUIRE(curve.powerPoint(g, order) == EllipticCurve::neutral);
+            REQUIRE(curve.pointOrder(g, 100) == order);
+        }
+
+        SECTION("Order with large prime factors"){
+            ///order 2^2 * 239 * 212131, both odd primes are above q^(1/4) and are found by Pollard's rho
+            const EllipticCurve curve(std::make_shared<const Field>(202788227_bn), 13919251_bn, 42104456_bn);
+            const lab::Point p = { 30388495_bn, 48191025_bn };
+            REQUIRE(curve.pointOrder(p) == 202797236_bn);
+        }
+    }
+    SECTION("Count points"){
+        SECTION("Legendre symbols"){
+            REQUIRE(curveDataBase[2].curves[0].countPoints() == 766_bn);
+            REQUIRE(curveDataBase[2].curves[1].countPoints() == 766_bn);
+        }
+
+        SECTION("Schoof"){
+            REQUIRE(curveDataBase[0].curves[0].countPoints() == 233392_bn);
+            REQUIRE(curveDataBase[0].curves[1].countPoints() == 234168_bn);
+
+            const auto field = std::make_shared<const Field>(1000003_bn);
+            REQUIRE(EllipticCurve(field, 0_bn, 7_bn).countPoints() == 999007_bn);
+            REQUIRE(EllipticCurve(field, 1000000_bn, 5_bn).countPoints() == 998588_bn);
+        }
+
+        SECTION("Order annihilates points"){
+            const auto& curve = curveDataBase[1].curves[0];
+            const lab::Point g = { 2_bn, 66988394260_bn };
+            REQUIRE(curve.powerPoint(g, curve.countPoints()) == EllipticCurve::neutral);
+        }
+    }
+
+    SECTION("Named curves"){
+        for (const auto& name : namedCurveNames()) {
+            const auto named = namedCurve(name);
+            REQUIRE(named->getName() == name);
+            REQUIRE(named->getCurve().contains(named->getGenerator()));
+            REQUIRE(named->getCurve().powerPoint(named->getGenerator(), named->getOrder()) == EllipticCurve::neutral);
+        }
+
+        REQUIRE(namedCurve("secp256k1") == namedCurve("secp256k1"));
+        REQUIRE(namedCurve("secp256k1")->getCurve().getEndomorphism().has_value());
+        REQUIRE(namedCurve("Curve25519")->getCofactor() == 8_bn);
+        REQUIRE(namedCurve("P-256")->getCurve().getShape() == EllipticCurve::Shape::AMinusThree);
+        REQUIRE_THROWS_AS(namedCurve("P-255"), std::invalid_argument);
+
+        const auto p256 = namedCurve("P-256");
+        const auto table = p256->getGeneratorTable();
+        REQUIRE(table == p256->getGeneratorTable());
+        const auto k = 98765678909876523456788987656789098765234567889876567890987652345678_bn;
+        REQUIRE(table->multiplyGenerator(k) == p256->getCurve().powerPoint(p256->getGenerator(), k));
     }
+
+    SECTION("Public key validation"){
+        const auto p256 = namedCurve("P-256");
+        const EllipticCurve& curve = p256->getCurve();
+        const Point& g = p256->getGenerator();
+        const BigNum& mod = curve.getFieldModulo();
+        REQUIRE(curve.isValidPublicKey(g));
+        REQUIRE(curve.isValidPublicKey(g, p256->getOrder()));
+        REQUIRE_FALSE(curve.isValidPublicKey(EllipticCurve::neutral));
+        REQUIRE_FALSE(curve.isValidPublicKey({ g.x, g.y + 1_bn }));
+        REQUIRE(curve.contains({ g.x + mod, g.y }));
+        REQUIRE_FALSE(curve.isValidPublicKey({ g.x + mod, g.y }));
+
+        ///Curve25519 has cofactor 8: (A/3, 0) is the image of Montgomery point (0, 0) of order 2
+        const auto curve25519 = namedCurve("Curve25519");
+        const Point small_order(19298681539552699237261830834781317975544997444273427339909597334652188435537_bn, 0_bn);
+        REQUIRE(curve25519->getCurve().isValidPublicKey(small_order));
+        REQUIRE_FALSE(curve25519->getCurve().isValidPublicKey(small_order, curve25519->getOrder()));
+        REQUIRE(curve25519->getCurve().isValidPublicKey(curve25519->getGenerator(), curve25519->getOrder()));
+
+        const auto cache = p256->getKeyCache();
+        REQUIRE(cache == p256->getKeyCache());
+        const auto k = 98765678909876523456788987656789098765234567889876567890987652345678_bn;
+        const auto encoded = curve.encodePoint(curve.powerPoint(g, k));
+        REQUIRE(cache->validate(encoded) == curve.powerPoint(g, k));
+        const auto cached = cache->size();
+        REQUIRE(cache->validate(encoded) == curve.powerPoint(g, k));
+        REQUIRE(cache->size() == cached);
+        REQUIRE_THROWS_AS(cache->validate({ 0x00 }), std::invalid_argument);
+        REQUIRE_THROWS_AS(curve25519->getKeyCache()->validate(curve25519->getCurve().encodePoint(small_order, false)),
+                          std::invalid_argument);
+
+        const PublicKeyCache bounded(curve, std::nullopt, 2);
+        for (const auto& scalar : { 2_bn, 3_bn, 4_bn })
+            bounded.validate(curve.encodePoint(curve.powerPoint(g, scalar)));
+        REQUIRE(bounded.size() == 2);
+    }
+
     SECTION("Curve conatains result"){
         SECTION("Adding points"){
             const lab::Point p1 = { 769_bn, 7_bn };
@@ -0,0 +1,125 @@
+#include <Field.hpp>
+#include <FieldElement.hpp>
+#include <EllipticCurves.hpp>
+
+#include "catch.hpp"
+
+TEST_CASE("Fields test", "[field]") {
+    using namespace lab;
+
+    SECTION("Invalid modulo") {
+        REQUIRE_THROWS_AS(Field(2_bn), std::invalid_argument);
+        REQUIRE_THROWS_AS(Field(1000000_bn), std::invalid_argument);
+    }
+
+    SECTION("Precomputed constants") {
+        const Field field(80000005213_bn);
+        REQUIRE(field.modulo() == 80000005213_bn);
+        REQUIRE(field.bitLength() == 37);
+        REQUIRE(field.byteLength() == 5);
+        REQUIRE(field.isPrime());
+        REQUIRE(field.montgomery().has_value());
+        REQUIRE_FALSE(Field(1000001_bn).isPrime());
+        REQUIRE_FALSE(Field(25_bn).montgomery().has_value());
+    }
+
+    SECTION("Arithmetic") {
+        const Field field(1000003_bn);
+        REQUIRE(field.multiply(999999_bn, 1000_bn) == (999999_bn * 1000_bn) % 1000003_bn);
+        REQUIRE(field.multiply(field.inverted(12345_bn), 12345_bn) == 1_bn);
+        REQUIRE(field.pow(2_bn, 1000002_bn) == 1_bn);
+        REQUIRE_THROWS_AS(field.inverted(1000003_bn), std::invalid_argument);
+    }
+
+    SECTION("Square roots by strategy") {
+        const auto check = [](const BigNum& modulo, Field::SqrtStrategy strategy) {
+            const Field field(modulo);
+            REQUIRE(field.getSqrtStrategy() == strategy);
+            for (const auto& num : { 4_bn, 12345_bn * 12345_bn, 987654_bn * 987654_bn, 0_bn }) {
+                const auto root = field.sqrt(num);
+                REQUIRE(root.has_value());
+                REQUIRE(field.multiply(*root, *root) == num % modulo);
+            }
+        };
+        check(1000003_bn, Field::SqrtStrategy::ThreeModFour);
+        check(1000037_bn, Field::SqrtStrategy::Atkin);
+        check(1000033_bn, Field::SqrtStrategy::TonelliShanks);
+        /// 3 * 2^30 + 1
+        check(3221225473_bn, Field::SqrtStrategy::Cipolla);
+
+        const Field field(1000003_bn);
+        REQUIRE_FALSE(field.sqrt(1000002_bn).has_value());
+        REQUIRE_THROWS_AS(Field(1000001_bn).sqrt(4_bn), std::logic_error);
+    }
+
+    SECTION("Montgomery context") {
+        const BigNum mod("115792089237316195423570985008687907853269984665640564039457584007908834671663");
+        const MontgomeryContext context(mod);
+        const BigNum left("98765432109876543210987654321098765432109876543210987654321098765432109876");
+        const BigNum right = mod - 1_bn;
+        REQUIRE(context.fromMontgomery(context.toMontgomery(left)) == left);
+        REQUIRE(context.fromMontgomery(context.one()) == 1_bn);
+        REQUIRE(context.fromMontgomery(context.multiply(context.toMontgomery(left), context.toMontgomery(right)))
+                == multiply(left, right, mod));
+        REQUIRE(context.pow(left, mod - 2_bn) == inverted(left, mod, BigNum::InversionPolicy::Euclid));
+        REQUIRE_THROWS_AS(MontgomeryContext(1000005_bn), std::invalid_argument);
+    }
+
+    SECTION("Field elements") {
+        for (const auto& modulo : { 1000003_bn, 25_bn }) {
+            const Field field(modulo);
+            const FieldElement a(field, 123456789_bn);
+            const FieldElement b(field, 987654_bn);
+            const BigNum plain_a = 123456789_bn % modulo;
+            const BigNum plain_b = 987654_bn % modulo;
+            REQUIRE(a.toBigNum() == plain_a);
+            REQUIRE((a + b).toBigNum() == add(plain_a, plain_b, modulo));
+            REQUIRE((a - b).toBigNum() == subtract(plain_a, plain_b, modulo));
+            REQUIRE((b - a).toBigNum() == subtract(plain_b, plain_a, modulo));
+            REQUIRE((a * b).toBigNum() == multiply(plain_a, plain_b, modulo));
+            REQUIRE((-a + a).isZero());
+            REQUIRE(a.doubled() == a + a);
+            REQUIRE(a.squared() == a * a);
+            REQUIRE(FieldElement::one(field) * a == a);
+            REQUIRE(FieldElement::zero(field) + a == a);
+        }
+
+        const Field field(1000003_bn);
+        const FieldElement a(field, 12345_bn);
+        REQUIRE(a * a.inverted() == FieldElement::one(field));
+        REQUIRE_THROWS_AS(FieldElement::zero(field).inverted(), std::invalid_argument);
+
+        std::vector<FieldElement> elements;
+        for (const auto& num : { 2_bn, 3_bn, 1000002_bn, 777_bn })
+            elements.emplace_back(field, num);
+        const auto inverses = invertedBatch(elements);
+        for (int i = 0; i < elements.size(); ++i)
+            REQUIRE(inverses[i] == elements[i].inverted());
+        REQUIRE(invertedBatch({}).empty());
+    }
+
+    SECTION("Lazy sums") {
+        for (const auto& modulo : { 1000003_bn, 25_bn }) {
+            const Field field(modulo);
+            const FieldElement a(field, modulo - 1_bn);
+            const FieldElement b(field, modulo - 2_bn);
+            const FieldElement c(field, 7_bn);
+            REQUIRE((a.lazy() + a + a).reduced() == a + a + a);
+            REQUIRE((a.lazy() + b + c + a).reduced() == a + b + c + a);
+            REQUIRE((a.lazy().doubled().doubled().doubled() + a.lazy().doubled()).reduced() == a * FieldElement(field, 10_bn));
+            REQUIRE((c.lazy() - a).reduced() == c - a);
+            REQUIRE((a.lazy() + b - c).reduced() == a + b - c);
+            const auto sum = b.lazy() + b;
+            REQUIRE(sum.reduced() == b.doubled());
+            REQUIRE((sum + sum).reduced() == b.doubled().doubled());
+        }
+    }
+
+    SECTION("Curves share field") {
+        const auto field = std::make_shared<const Field>(1000003_bn);
+        const EllipticCurve curve(field, 0_bn, 7_bn);
+        const EllipticCurve copy = curve;
+        REQUIRE(copy.getField() == field);
+        REQUIRE(field.use_count() == 3);
+    }
+}
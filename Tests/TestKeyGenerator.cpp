@@ -19,6 +19,77 @@ TEST_CASE("Key generation test","[keyGen]") {
             REQUIRE(bob.getPrivateKey() == curv.powerPoint(curv.powerPoint(point, powA), powB));
 
         }
+
+        SECTION("Public key from generator table"){
+            auto pow = 98765678909876523456788_bn;
+            auto curv = curveDataBase[1].curves[0];
+            auto point = Point(2_bn, 66988394260_bn);
+            auto ali = Client(curv, pow, std::make_shared<const FixedBaseTable>(curv, point));
+            REQUIRE(ali.getPublicKey() == Client(curv, pow, point).getPublicKey());
+
+            const auto table = std::make_shared<const FixedBaseTable>(curv, point);
+            REQUIRE_THROWS_AS(Client(curveDataBase[1].curves[2], pow, table), std::invalid_argument);
+            REQUIRE_THROWS_AS(ali.setKeyCache(namedCurve("P-256")->getKeyCache()), std::invalid_argument);
+        }
+    }
+
+    SECTION("x-only client"){
+        const auto powA = 98765678909876523456788_bn, powB = 987657904356814_bn;
+        auto ali = Client(curve25519(), powA, 9_bn);
+        auto bob = Client(curve25519(), powB, 9_bn);
+        REQUIRE(ali.isXOnly());
+        REQUIRE(ali.getEncodedPublicKey().size() == 32);
+        ali.setPrivateKey(bob.getEncodedPublicKey());
+        bob.setPrivateKey(ali.getEncodedPublicKey());
+        REQUIRE(ali.getEncodedPrivateKey() == bob.getEncodedPrivateKey());
+        REQUIRE(curve25519().decodeU(ali.getEncodedPrivateKey()) == curve25519().ladder(9_bn, powA * powB));
+        REQUIRE_THROWS_AS(ali.getPublicKey(), std::logic_error);
+
+        ///the same exchange on the equivalent Weierstrass curve agrees on x = u + A/3
+        const auto named = namedCurve("Curve25519");
+        auto carol = Client(named->getCurve(), powA, named->getGenerator());
+        auto dave = Client(named->getCurve(), powB, named->getGenerator());
+        REQUIRE_FALSE(carol.isXOnly());
+        carol.setPrivateKey(dave.getEncodedPublicKey());
+        dave.setPrivateKey(carol.getEncodedPublicKey());
+        REQUIRE(carol.getEncodedPrivateKey() == dave.getEncodedPrivateKey());
+        REQUIRE(curve25519().toWeierstrass({ curve25519().decodeU(ali.getEncodedPrivateKey()), 0_bn }).x
+                == carol.getPrivateKey().x);
+
+        SECTION("Private key before exchange"){
+            auto erin = Client(curve25519(), powA, 9_bn);
+            REQUIRE_THROWS_WITH(erin.getEncodedPrivateKey(), Catch::Contains("not set"));
+            auto frank = Client(named->getCurve(), powA, named->getGenerator());
+            REQUIRE_THROWS_WITH(frank.getEncodedPrivateKey(), Catch::Contains("not set"));
+            REQUIRE_THROWS_AS(frank.getPrivateKey(), std::logic_error);
+        }
+
+        SECTION("Low order public key"){
+            ///u = 0 is the point of order 2, every multiple has u = 0 or is neutral
+            ali.setPrivateKey(std::vector<uint8_t>(32, 0));
+            REQUIRE_THROWS_AS(ali.getEncodedPrivateKey(), std::invalid_argument);
+
+            ///its Weierstrass image (A/3, 0) times even scalar is neutral
+            carol.setPrivateKey(curve25519().toWeierstrass({ 0_bn, 0_bn }));
+            REQUIRE(carol.getPrivateKey() == EllipticCurve::neutral);
+            REQUIRE_THROWS_AS(carol.getEncodedPrivateKey(), std::invalid_argument);
+        }
+    }
+
+    SECTION("Client with key cache"){
+        const auto named = namedCurve("P-256");
+        auto ali = Client(named->getCurve(), 98765678909876523456788_bn, named->getGenerator());
+        auto bob = Client(named->getCurve(), 987657904356814_bn, named->getGenerator());
+        ali.setKeyCache(named->getKeyCache());
+        bob.setKeyCache(named->getKeyCache());
+        ali.setPrivateKey(bob.getEncodedPublicKey());
+        bob.setPrivateKey(ali.getEncodedPublicKey());
+        ali.setPrivateKey(bob.getEncodedPublicKey());
+        REQUIRE(ali.getPrivateKey() == bob.getPrivateKey());
+
+        auto bad_key = bob.getEncodedPublicKey();
+        bad_key[0] = 0x04;
+        REQUIRE_THROWS_AS(ali.setPrivateKey(bad_key), std::invalid_argument);
     }
 
     SECTION("Comparing got private keys"){
@@ -0,0 +1,109 @@
+#include <Polynomial.hpp>
+
+#include <sstream>
+
+#include "catch.hpp"
+
+TEST_CASE("Polynomials test", "[polynomial]") {
+    using namespace lab;
+
+    const auto field = std::make_shared<const Field>(1000003_bn);
+
+    SECTION("Streaming a Polynomial") {
+        std::stringstream out;
+        out << Polynomial(field, { 5_bn, 0_bn, 1_bn, 2_bn });
+        REQUIRE(out.str() == "2*x^3 + x^2 + 5");
+    }
+
+    SECTION("Coefficients are reduced and trimmed") {
+        const Polynomial poly(field, { 1000004_bn, 1000003_bn, 0_bn });
+        REQUIRE(poly.degree() == 0);
+        REQUIRE(poly[0] == 1_bn);
+        REQUIRE(poly[5] == 0_bn);
+        REQUIRE(Polynomial(field).degree() == -1);
+        REQUIRE(Polynomial(field, { 0_bn }).isZero());
+    }
+
+    SECTION("Add and subtract") {
+        const Polynomial left(field, { 1_bn, 2_bn, 3_bn });
+        const Polynomial right(field, { 1000002_bn, 5_bn, 1000000_bn });
+        REQUIRE(left + right == Polynomial(field, { 0_bn, 7_bn }));
+        REQUIRE((left - left).isZero());
+        REQUIRE(left - right == Polynomial(field, { 2_bn, 1000000_bn, 6_bn }));
+    }
+
+    SECTION("Multiply") {
+        /// (x + 1)(x - 1) = x^2 - 1
+        const Polynomial left(field, { 1_bn, 1_bn });
+        const Polynomial right(field, { 1000002_bn, 1_bn });
+        REQUIRE(left * right == Polynomial(field, { 1000002_bn, 0_bn, 1_bn }));
+        REQUIRE((left * Polynomial(field)).isZero());
+        REQUIRE(left * 3_bn == Polynomial(field, { 3_bn, 3_bn }));
+
+        /// long product is checked by evaluation at a point
+        std::vector<BigNum> first, second;
+        for (int i = 0; i < 200; ++i) {
+            first.push_back(BigNum(std::to_string(i * 7919 + 13)));
+            second.push_back(BigNum(std::to_string(999983 - i * 4241)));
+        }
+        const Polynomial long_left(field, first);
+        const Polynomial long_right(field, second);
+        const BigNum x = 123457_bn;
+        REQUIRE((long_left * long_right).evaluate(x) ==
+                multiply(long_left.evaluate(x), long_right.evaluate(x), field->modulo()));
+    }
+
+    SECTION("Divide") {
+        const Polynomial dividend(field, { 7_bn, 0_bn, 5_bn, 3_bn, 1_bn });
+        const Polynomial divisor(field, { 2_bn, 0_bn, 4_bn });
+        const auto [quotient, remainder] = divide(dividend, divisor);
+        REQUIRE(remainder.degree() < divisor.degree());
+        REQUIRE(quotient * divisor + remainder == dividend);
+        REQUIRE_THROWS_AS(dividend / Polynomial(field), std::invalid_argument);
+    }
+
+    SECTION("Gcd") {
+        /// (x - 1)(x - 2) and (x - 1)(x + 5)
+        const Polynomial common(field, { 1000002_bn, 1_bn });
+        const Polynomial left = common * Polynomial(field, { 1000001_bn, 1_bn });
+        const Polynomial right = common * Polynomial(field, { 5_bn, 1_bn }) * 7_bn;
+        REQUIRE(gcd(left, right) == common);
+
+        const auto [divisor, inverse] = extendedGcd(Polynomial(field, { 5_bn, 1_bn }), left);
+        REQUIRE(divisor == Polynomial(field, { 1_bn }));
+        REQUIRE((inverse * Polynomial(field, { 5_bn, 1_bn })) % left == Polynomial(field, { 1_bn }));
+    }
+
+    SECTION("Derivative and evaluation") {
+        const Polynomial poly(field, { 7_bn, 0_bn, 5_bn, 3_bn });
+        REQUIRE(poly.derivative() == Polynomial(field, { 0_bn, 10_bn, 9_bn }));
+        REQUIRE(poly.evaluate(2_bn) == 51_bn);
+        REQUIRE(Polynomial::monomial(field, 3, 2_bn) == Polynomial(field, { 0_bn, 0_bn, 0_bn, 2_bn }));
+    }
+
+    SECTION("Reduction by fixed modulus") {
+        const Polynomial modulus(field, { 3_bn, 1_bn, 0_bn, 0_bn, 0_bn, 0_bn, 0_bn, 2_bn });
+        const PolynomialModulus context(modulus);
+        REQUIRE(context.modulo() == modulus.monic());
+
+        std::vector<BigNum> coefficients;
+        for (int i = 0; i < 13; ++i)
+            coefficients.push_back(BigNum(std::to_string(i * i * 1237 + 1)));
+        const Polynomial poly(field, coefficients);
+        REQUIRE(context.reduce(poly) == poly % modulus);
+        REQUIRE(context.reduce(poly * poly) == (poly * poly) % modulus);
+        REQUIRE_THROWS_AS(PolynomialModulus(Polynomial(field, { 5_bn })), std::invalid_argument);
+    }
+
+    SECTION("Power modulo polynomial") {
+        /// x^p = x modulo x^3 - x, since every residue is a root of x^p - x
+        const Polynomial x = Polynomial::monomial(field, 1);
+        const PolynomialModulus context(Polynomial::monomial(field, 3) - x);
+        REQUIRE(context.pow(x, field->modulo()) == x);
+        REQUIRE(context.pow(x, 0_bn) == Polynomial(field, { 1_bn }));
+
+        /// x^(p - 1) = 1 modulo irreducible x^2 + 1 gives x^(p^2 - 1) = 1, p = 3 (mod 4)
+        const PolynomialModulus irreducible(Polynomial(field, { 1_bn, 0_bn, 1_bn }));
+        REQUIRE(irreducible.pow(x, field->modulo() * field->modulo() - 1_bn) == Polynomial(field, { 1_bn }));
+    }
+}